@@ -0,0 +1,159 @@
+#pragma once
+#include <climits>
+#include <deque>
+#include <span>
+#include "models/fill.hpp"
+#include "models/top_of_book.hpp"
+#include "utils/seqlock.hpp"
+
+struct MicrostructureConfig {
+    uint32_t depthLevels = 5;                   // levels per side in the depth imbalance
+    Timestamp realizedSpreadHorizon = 1000;     // fill timestamp to mid observation, in engine time units
+};
+
+// Running totals since construction or reset(). Spreads are kept as sums of
+// qty * d * (2 * price - bid - ask), d = +1 for a buying taker, which is exact in ticks;
+// the averages divide by the volume that had a two-sided mid.
+struct MicrostructureSnapshot {
+    uint64_t events = 0;
+    uint64_t trades = 0;
+    int64_t volume = 0;
+    int64_t buyVolume = 0;              // taker buys
+    int64_t notional = 0;               // sum of price * qty, in ticks
+    int64_t orderFlowImbalance = 0;     // cumulative best bid/ask order flow imbalance
+    int64_t bidDepth = 0;               // quantity on the best depthLevels bid levels
+    int64_t askDepth = 0;
+    int64_t effectiveSpreadSum = 0;     // against the mid before the fill
+    int64_t effectiveSpreadVolume = 0;
+    int64_t realizedSpreadSum = 0;      // against the first mid at least the horizon after the fill
+    int64_t realizedSpreadVolume = 0;
+
+    inline int64_t sellVolume() const { return volume - buyVolume; }
+    inline double vwap() const { return volume ? static_cast<double>(notional) / volume : 0.0; }
+
+    // In [-1, 1]; positive when the bid side is deeper.
+    inline double depthImbalance() const {
+        int64_t total = bidDepth + askDepth;
+        return total ? static_cast<double>(bidDepth - askDepth) / total : 0.0;
+    }
+
+    inline double effectiveSpread() const {
+        return effectiveSpreadVolume ? static_cast<double>(effectiveSpreadSum) / effectiveSpreadVolume : 0.0;
+    }
+
+    inline double realizedSpread() const {
+        return realizedSpreadVolume ? static_cast<double>(realizedSpreadSum) / realizedSpreadVolume : 0.0;
+    }
+};
+
+// Market-quality measures for one book, updated from each engine event instead of being
+// recomputed from the book. Call onEvent after every matchOrder, uncross or cancel with
+// that call's fills (empty for a cancel) and the engine time. Each call costs the fills
+// it carries, one top-of-book capture and a walk of depthLevels levels per side; fills
+// waiting for their realized spread horizon sit in a FIFO and leave it once. A book
+// holds one instrument, so per-symbol analytics means one instance per book.
+//
+// Order flow imbalance follows Cont, Kukanov and Stoikov: each event adds the change in
+// best-bid queue (in full when the bid improves, minus the old queue when it retreats)
+// and subtracts the corresponding change on the ask. A missing bid counts as price 0 and
+// a missing ask as an infinitely high one.
+template <typename Book>
+class MicrostructureAnalytics {
+    public:
+        using EngineFill = BasicFill<typename Book::BookOrder>;
+
+    private:
+        struct PendingFill {
+            Timestamp due;
+            PriceTicks price;
+            Quantity qty;
+            int sign;
+        };
+
+        const Book* book;
+        MicrostructureConfig config;
+        MicrostructureSnapshot current;
+        TopOfBook top;
+        std::deque<PendingFill> pending;
+        Seqlock<MicrostructureSnapshot>* feed = nullptr;
+
+        static inline bool hasMid(const TopOfBook &quote) { return quote.hasBid() && quote.hasAsk(); }
+        static inline PriceTicks askOrMax(const TopOfBook &quote) { return quote.hasAsk() ? quote.askPrice : LLONG_MAX; }
+
+        static int64_t flowImbalance(const TopOfBook &before, const TopOfBook &after) {
+            int64_t flow = 0;
+            if (after.bidPrice >= before.bidPrice) flow += after.bidQty;
+            if (after.bidPrice <= before.bidPrice) flow -= before.bidQty;
+            PriceTicks askBefore = askOrMax(before);
+            PriceTicks askAfter = askOrMax(after);
+            if (askAfter <= askBefore) flow -= after.askQty;
+            if (askAfter >= askBefore) flow += before.askQty;
+            return flow;
+        }
+
+        template <typename Levels>
+        int64_t depthOf(const Levels &levels) const {
+            int64_t depth = 0;
+            uint32_t remaining = config.depthLevels;
+            levels.forEachLevel([&](PriceTicks, const auto &level) {
+                depth += level.totalQty;
+                return --remaining > 0;
+            });
+            return depth;
+        }
+
+    public:
+        explicit MicrostructureAnalytics(const Book* book_, MicrostructureConfig config_ = {})
+            : book(book_), config(config_), top(TopOfBook::capture(*book_, 0)) {
+            if (config.depthLevels == 0) config.depthLevels = 1;
+            current.bidDepth = depthOf(book->getBids());
+            current.askDepth = depthOf(book->getAsks());
+        }
+
+        // Every onEvent also stores the snapshot to feed once set, for readers on other threads.
+        inline void setFeed(Seqlock<MicrostructureSnapshot>* feed_) { feed = feed_; }
+
+        inline const MicrostructureSnapshot& snapshot() const { return current; }
+        inline size_t pendingRealizedCount() const { return pending.size(); }
+
+        void onEvent(std::span<const EngineFill> fills, Timestamp now) {
+            ++current.events;
+            for (const EngineFill& fill : fills) {
+                int sign = fill.takerSide == Side::Buy ? 1 : -1;
+                ++current.trades;
+                current.volume += fill.qty;
+                if (sign > 0) current.buyVolume += fill.qty;
+                current.notional += fill.price * fill.qty;
+                if (hasMid(top)) {
+                    current.effectiveSpreadSum += sign * fill.qty * (2 * fill.price - top.bidPrice - top.askPrice);
+                    current.effectiveSpreadVolume += fill.qty;
+                }
+                pending.push_back(PendingFill{static_cast<Timestamp>(fill.timestamp) + config.realizedSpreadHorizon, fill.price, fill.qty, sign});
+            }
+
+            TopOfBook next = TopOfBook::capture(*book, current.events);
+            current.orderFlowImbalance += flowImbalance(top, next);
+            top = next;
+            current.bidDepth = depthOf(book->getBids());
+            current.askDepth = depthOf(book->getAsks());
+
+            if (hasMid(top)) {
+                while (!pending.empty() && pending.front().due <= now) {
+                    const PendingFill& fill = pending.front();
+                    current.realizedSpreadSum += fill.sign * fill.qty * (2 * fill.price - top.bidPrice - top.askPrice);
+                    current.realizedSpreadVolume += fill.qty;
+                    pending.pop_front();
+                }
+            }
+            if (feed) feed->store(current);
+        }
+
+        // Zeroes the totals and drops pending fills; depth and top of book are re-read.
+        void reset() {
+            current = MicrostructureSnapshot{};
+            pending.clear();
+            top = TopOfBook::capture(*book, 0);
+            current.bidDepth = depthOf(book->getBids());
+            current.askDepth = depthOf(book->getAsks());
+        }
+};
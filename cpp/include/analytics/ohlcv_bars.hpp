@@ -0,0 +1,180 @@
+#pragma once
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <vector>
+#include "models/fill.hpp"
+
+struct Bar {
+    Timestamp start = 0;        // first engine time unit of the interval
+    PriceTicks open = 0;
+    PriceTicks high = 0;
+    PriceTicks low = 0;
+    PriceTicks close = 0;
+    int64_t volume = 0;
+    int64_t notional = 0;       // sum of price * qty, in ticks
+    uint32_t trades = 0;
+
+    inline double vwap() const { return volume ? static_cast<double>(notional) / volume : 0.0; }
+
+    void add(PriceTicks price, Quantity qty) {
+        if (trades == 0) {
+            open = high = low = price;
+        }
+        high = std::max(high, price);
+        low = std::min(low, price);
+        close = price;
+        volume += qty;
+        notional += price * qty;
+        ++trades;
+    }
+
+    // Appends a later bar of a finer resolution.
+    void merge(const Bar &later) {
+        if (trades == 0) {
+            open = later.open;
+            high = later.high;
+            low = later.low;
+        }
+        high = std::max(high, later.high);
+        low = std::min(low, later.low);
+        close = later.close;
+        volume += later.volume;
+        notional += later.notional;
+        trades += later.trades;
+    }
+};
+
+// Fixed-capacity store of the most recent bars, oldest first; a full ring overwrites its
+// oldest bar.
+class BarRing {
+    private:
+        std::vector<Bar> bars;
+        size_t head = 0;        // index of the oldest bar
+        size_t count = 0;
+        uint64_t emitted = 0;
+
+    public:
+        explicit BarRing(size_t capacity) : bars(capacity) {}
+
+        inline size_t size() const { return count; }
+        inline size_t capacity() const { return bars.size(); }
+        inline bool empty() const { return count == 0; }
+        inline uint64_t totalEmitted() const { return emitted; }
+
+        inline const Bar& operator[](size_t i) const { return bars[(head + i) % bars.size()]; }
+        inline const Bar& back() const { return (*this)[count - 1]; }
+
+        void push(const Bar &bar) {
+            if (count < bars.size()) {
+                bars[(head + count++) % bars.size()] = bar;
+            } else {
+                bars[head] = bar;
+                head = (head + 1) % bars.size();
+            }
+            ++emitted;
+        }
+};
+
+struct BarResolution {
+    Timestamp interval;     // in engine time units
+    size_t capacity;        // bars kept
+};
+
+// Builds OHLCV bars from fills at the first resolution and rolls each closed bar up into
+// the coarser ones, so no resolution re-reads trades. A bar closes when a fill or
+// advanceTo() reaches the end of its interval; intervals without trades produce no bar.
+// Each resolution keeps its closed bars in a preallocated BarRing. One aggregator covers
+// one book's fills.
+class BarAggregator {
+    private:
+        struct Tier {
+            Timestamp interval;
+            BarRing closed;
+            Bar current;
+            bool hasCurrent = false;
+        };
+
+        std::vector<Tier> tiers;
+
+        explicit BarAggregator(const std::vector<BarResolution> &resolutions) {
+            tiers.reserve(resolutions.size());
+            for (const BarResolution& resolution : resolutions) {
+                tiers.push_back(Tier{resolution.interval, BarRing(resolution.capacity), Bar{}, false});
+            }
+        }
+
+        inline Timestamp startOf(const Tier &tier, Timestamp time) const { return time - time % tier.interval; }
+
+        void close(size_t index) {
+            Tier& tier = tiers[index];
+            tier.closed.push(tier.current);
+            tier.hasCurrent = false;
+            if (index != 0) return;
+            for (size_t coarser = 1; coarser < tiers.size(); ++coarser) {
+                Tier& rollup = tiers[coarser];
+                Timestamp start = startOf(rollup, tier.current.start);
+                if (rollup.hasCurrent && rollup.current.start != start) close(coarser);
+                if (!rollup.hasCurrent) {
+                    rollup.current = Bar{};
+                    rollup.current.start = start;
+                    rollup.hasCurrent = true;
+                }
+                rollup.current.merge(tier.current);
+            }
+        }
+
+    public:
+        // The first interval is built from fills and every later one must be a multiple of it.
+        // Returns nullopt for an empty list, a zero interval or capacity, or a non-multiple.
+        static std::optional<BarAggregator> create(const std::vector<BarResolution> &resolutions) {
+            if (resolutions.empty()) return std::nullopt;
+            for (const BarResolution& resolution : resolutions) {
+                if (resolution.interval == 0 || resolution.capacity == 0) return std::nullopt;
+                if (resolution.interval % resolutions.front().interval != 0) return std::nullopt;
+            }
+            return BarAggregator(resolutions);
+        }
+
+        // 1s, 1m, 5m and 1h for a clock with second time units per second.
+        static BarAggregator standard(Timestamp second, size_t capacity) {
+            return BarAggregator({{second, capacity}, {60 * second, capacity}, {300 * second, capacity}, {3600 * second, capacity}});
+        }
+
+        inline size_t resolutionCount() const { return tiers.size(); }
+        inline Timestamp getInterval(size_t resolution) const { return tiers[resolution].interval; }
+        inline const BarRing& getBars(size_t resolution) const { return tiers[resolution].closed; }
+
+        // The bar still open at this resolution, if it has trades. Coarser bars include only
+        // the finer bars closed so far.
+        std::optional<Bar> getOpenBar(size_t resolution) const {
+            const Tier& tier = tiers[resolution];
+            if (!tier.hasCurrent) return std::nullopt;
+            return tier.current;
+        }
+
+        // Closes every bar whose interval ends at or before now, finest first.
+        void advanceTo(Timestamp now) {
+            for (size_t index = 0; index < tiers.size(); ++index) {
+                Tier& tier = tiers[index];
+                if (tier.hasCurrent && now >= tier.current.start + tier.interval) close(index);
+            }
+        }
+
+        // Fills earlier than the open bar's interval are folded into it.
+        void onFill(PriceTicks price, Quantity qty, Timestamp timestamp) {
+            advanceTo(timestamp);
+            Tier& base = tiers.front();
+            if (!base.hasCurrent) {
+                base.current = Bar{};
+                base.current.start = startOf(base, timestamp);
+                base.hasCurrent = true;
+            }
+            base.current.add(price, qty);
+        }
+
+        template <typename FillT>
+        void onFills(std::span<const FillT> fills) {
+            for (const FillT& fill : fills) onFill(fill.price, fill.qty, static_cast<Timestamp>(fill.timestamp));
+        }
+};
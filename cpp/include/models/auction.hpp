@@ -0,0 +1,87 @@
+#pragma once
+#include <algorithm>
+#include <optional>
+#include <span>
+#include "models/order.hpp"
+
+struct DepthPoint {
+    PriceTicks price;
+    int64_t qty;
+};
+
+struct AuctionEquilibrium {
+    PriceTicks price;
+    int64_t volume;         // executable qty at price
+    int64_t imbalance;      // cumulative demand minus cumulative supply at price
+};
+
+// Call-auction price discovery over aggregated depth. One ascending merge of the two
+// sides yields cumulative supply (asks <= p) and demand (bids >= p) at every candidate
+// price. The uncross price maximises executable volume, then minimises |imbalance|,
+// then follows market pressure: highest price on a buy surplus, lowest otherwise.
+class AuctionUncross {
+    public:
+        static std::optional<AuctionEquilibrium> findEquilibrium(
+            std::span<const DepthPoint> bidsBestFirst,
+            std::span<const DepthPoint> asksBestFirst
+        ) {
+            if (bidsBestFirst.empty() || asksBestFirst.empty()) return std::nullopt;
+            PriceTicks bestBid = bidsBestFirst.front().price;
+            PriceTicks bestAsk = asksBestFirst.front().price;
+            if (bestBid < bestAsk) return std::nullopt;
+
+            int64_t totalDemand = 0;
+            for (const DepthPoint &bid : bidsBestFirst) totalDemand += bid.qty;
+
+            // Bids are read worst-first so both sides ascend together.
+            size_t bidCount = bidsBestFirst.size();
+            auto bidAscending = [&](size_t k) -> const DepthPoint& { return bidsBestFirst[bidCount - 1 - k]; };
+
+            std::optional<AuctionEquilibrium> best;
+            size_t askIndex = 0;
+            size_t bidCandidate = 0;    // next bid price to visit as a candidate
+            size_t bidBelow = 0;        // bids already priced under the current candidate
+            int64_t demandBelow = 0;
+            int64_t supply = 0;
+            while (bidCandidate < bidCount || askIndex < asksBestFirst.size()) {
+                PriceTicks price = bidCandidate < bidCount ? bidAscending(bidCandidate).price : bestBid + 1;
+                if (askIndex < asksBestFirst.size()) {
+                    price = std::min(price, asksBestFirst[askIndex].price);
+                }
+                if (price > bestBid) break;
+
+                while (askIndex < asksBestFirst.size() && asksBestFirst[askIndex].price <= price) {
+                    supply += asksBestFirst[askIndex++].qty;
+                }
+                while (bidBelow < bidCount && bidAscending(bidBelow).price < price) {
+                    demandBelow += bidAscending(bidBelow++).qty;
+                }
+                while (bidCandidate < bidCount && bidAscending(bidCandidate).price <= price) {
+                    ++bidCandidate;
+                }
+                int64_t demand = totalDemand - demandBelow;
+                if (price >= bestAsk) {
+                    consider(best, AuctionEquilibrium{price, std::min(demand, supply), demand - supply});
+                }
+            }
+            if (!best || best->volume == 0) return std::nullopt;
+            return best;
+        }
+
+    private:
+        static void consider(std::optional<AuctionEquilibrium> &best, const AuctionEquilibrium &candidate) {
+            if (!best) {
+                best = candidate;
+                return;
+            }
+            int64_t candidateImbalance = candidate.imbalance < 0 ? -candidate.imbalance : candidate.imbalance;
+            int64_t bestImbalance = best->imbalance < 0 ? -best->imbalance : best->imbalance;
+            if (candidate.volume != best->volume) {
+                if (candidate.volume > best->volume) best = candidate;
+            } else if (candidateImbalance != bestImbalance) {
+                if (candidateImbalance < bestImbalance) best = candidate;
+            } else if (candidate.imbalance > 0) {
+                best = candidate;   // buy pressure: prefer the higher price (candidates ascend)
+            }
+        }
+};
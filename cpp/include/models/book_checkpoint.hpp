@@ -0,0 +1,181 @@
+#pragma once
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+#include "models/order_book.hpp"
+
+enum class CheckpointError : uint8_t {
+    None,                   // checkpoint restored
+    Truncated,              // buffer shorter than the header or the declared record count
+    BadMagic,               // buffer is not a book checkpoint
+    UnsupportedVersion,     // written with a different record layout
+    TargetNotEmpty,         // book or order storage already holds orders
+    InvalidRecord           // record fails validation or breaks price/FIFO ordering
+};
+
+// Records are written host-endian: bids best to worst, then asks best to worst,
+// each level in FIFO order. That ordering lets load() append levels at the end
+// of the price maps and skip the per-order lookups done by addOrder. Fields are as
+// wide as the widest order traits, so any book can be saved; load() rejects values
+// its book's order type cannot hold.
+struct CheckpointHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint64_t journalSequence;
+    uint64_t bidCount;
+    uint64_t askCount;
+};
+
+struct CheckpointRecord {
+    PriceTicks priceTicks;
+    Timestamp timestamp;
+    uint64_t orderID;
+    OwnerID ownerID;
+    Quantity qty;
+    Side side;
+    OrderType type;
+    OrderStatus status;
+};
+
+static_assert(sizeof(CheckpointHeader) == 32);
+static_assert(sizeof(CheckpointRecord) == 40);
+
+class BookCheckpoint {
+    private:
+        static constexpr uint32_t MAGIC = 0x4B424F4C;  // "LOBK"
+        static constexpr uint16_t VERSION = 2;
+
+        template <typename OrderT>
+        static CheckpointRecord toRecord(const OrderT* order) {
+            CheckpointRecord record;
+            std::memset(&record, 0, sizeof(record));
+            record.priceTicks = order->getPriceTicks();
+            record.timestamp = order->getTimestamp();
+            record.orderID = order->getOrderID();
+            record.ownerID = order->getOwnerID();
+            record.qty = order->getQty();
+            record.side = order->getSide();
+            record.type = order->getType();
+            record.status = order->getStatus();
+            return record;
+        }
+
+        template <typename OrderT>
+        static bool isRestorable(const CheckpointRecord &record, Side side) {
+            return record.side == side
+                && std::in_range<typename OrderT::Price>(record.priceTicks)
+                && std::in_range<typename OrderT::Qty>(record.qty)
+                && std::in_range<typename OrderT::ID>(record.orderID)
+                && std::in_range<typename OrderT::Owner>(record.ownerID)
+                && std::in_range<typename OrderT::Time>(record.timestamp)
+                && record.type == OrderType::Limit
+                && record.qty > 0
+                && record.priceTicks > 0
+                && (record.status == OrderStatus::Pending || record.status == OrderStatus::PartiallyExecuted);
+        }
+
+        template <typename Levels>
+        static void appendLevels(const Levels &levels, std::byte* &out) {
+            levels.forEachLevel([&](PriceTicks, const auto &level) {
+                for (const auto* order : level.orders) {
+                    CheckpointRecord record = toRecord(order);
+                    std::memcpy(out, &record, sizeof(record));
+                    out += sizeof(record);
+                }
+                return true;
+            });
+        }
+
+        template <typename Levels>
+        static uint64_t countOrders(const Levels &levels) {
+            uint64_t count = 0;
+            levels.forEachLevel([&](PriceTicks, const auto &level) {
+                count += level.orders.size();
+                return true;
+            });
+            return count;
+        }
+
+        template <typename OrderT>
+        static bool readSide(const std::byte* &in, uint64_t count, Side side, std::vector<OrderT> &storage) {
+            for (uint64_t i = 0; i < count; ++i) {
+                CheckpointRecord record;
+                std::memcpy(&record, in, sizeof(record));
+                in += sizeof(record);
+                if (!isRestorable<OrderT>(record, side)) {
+                    return false;
+                }
+                storage.emplace_back(
+                    static_cast<typename OrderT::ID>(record.orderID), static_cast<typename OrderT::Owner>(record.ownerID),
+                    static_cast<typename OrderT::Price>(record.priceTicks), static_cast<typename OrderT::Qty>(record.qty),
+                    record.side, record.type, static_cast<typename OrderT::Time>(record.timestamp)
+                ).setStatus(record.status);
+            }
+            return true;
+        }
+
+    public:
+        // journalSequence is stored verbatim so a restart can replay the journal tail after it.
+        template <typename LevelIndex>
+        static std::vector<std::byte> save(const BasicLimitOrderBook<LevelIndex> &book, uint64_t journalSequence = 0) {
+            uint64_t bidCount = countOrders(book.getBids());
+            uint64_t askCount = countOrders(book.getAsks());
+
+            CheckpointHeader header{MAGIC, VERSION, sizeof(CheckpointRecord), journalSequence, bidCount, askCount};
+            std::vector<std::byte> data(sizeof(header) + (bidCount + askCount) * sizeof(CheckpointRecord));
+            std::memcpy(data.data(), &header, sizeof(header));
+            std::byte* out = data.data() + sizeof(header);
+            appendLevels(book.getBids(), out);
+            appendLevels(book.getAsks(), out);
+            return data;
+        }
+
+        // Rebuilds the book with one bulkLoad. Restored orders are owned by storage, which must
+        // be empty; on failure both the book and storage are left empty.
+        template <typename LevelIndex>
+        static CheckpointError load(
+            std::span<const std::byte> data,
+            BasicLimitOrderBook<LevelIndex> &book,
+            std::vector<typename BasicLimitOrderBook<LevelIndex>::BookOrder> &storage,
+            uint64_t* journalSequence = nullptr
+        ) {
+            if (book.getOrderCount() != 0 || !storage.empty()) {
+                return CheckpointError::TargetNotEmpty;
+            }
+            CheckpointHeader header;
+            if (data.size() < sizeof(header)) {
+                return CheckpointError::Truncated;
+            }
+            std::memcpy(&header, data.data(), sizeof(header));
+            if (header.magic != MAGIC) {
+                return CheckpointError::BadMagic;
+            }
+            if (header.version != VERSION || header.recordSize != sizeof(CheckpointRecord)) {
+                return CheckpointError::UnsupportedVersion;
+            }
+            uint64_t available = (data.size() - sizeof(header)) / sizeof(CheckpointRecord);
+            if (header.bidCount > available || header.askCount > available - header.bidCount) {
+                return CheckpointError::Truncated;
+            }
+
+            uint64_t total = header.bidCount + header.askCount;
+            storage.reserve(total);
+            const std::byte* in = data.data() + sizeof(header);
+            bool valid = readSide(in, header.bidCount, Side::Buy, storage) && readSide(in, header.askCount, Side::Sell, storage);
+            if (valid) {
+                std::vector<typename BasicLimitOrderBook<LevelIndex>::Handle> handles(storage.size());
+                for (size_t i = 0; i < storage.size(); ++i) handles[i] = &storage[i];
+                valid = book.bulkLoad(handles).reason == RejectionReason::None;
+            }
+            if (!valid) {
+                storage.clear();
+                return CheckpointError::InvalidRecord;
+            }
+            if (journalSequence) {
+                *journalSequence = header.journalSequence;
+            }
+            return CheckpointError::None;
+        }
+};
@@ -0,0 +1,234 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "models/order_book.hpp"
+
+// Levels whose prices share price / CHUNK_TICKS, ascending by price, as parallel arrays.
+// Chunks are immutable once published and shared by every snapshot until one of their
+// levels changes, so a publish rebuilds only the chunks touched since the last one.
+struct DepthChunk {
+    static constexpr PriceTicks CHUNK_TICKS = 64;
+
+    std::vector<PriceTicks> prices;
+    std::vector<int64_t> quantities;
+    std::vector<uint32_t> orderCounts;
+
+    static constexpr PriceTicks keyOf(PriceTicks price) {
+        return price >= 0 ? price / CHUNK_TICKS : (price - CHUNK_TICKS + 1) / CHUNK_TICKS;
+    }
+
+    inline bool empty() const { return prices.empty(); }
+
+    template <typename Level>
+    void set(PriceTicks price, const Level* level) {
+        auto it = std::lower_bound(prices.begin(), prices.end(), price);
+        size_t index = static_cast<size_t>(it - prices.begin());
+        bool present = it != prices.end() && *it == price;
+        if (!level) {
+            if (!present) return;
+            prices.erase(it);
+            quantities.erase(quantities.begin() + index);
+            orderCounts.erase(orderCounts.begin() + index);
+            return;
+        }
+        if (!present) {
+            prices.insert(it, price);
+            quantities.insert(quantities.begin() + index, 0);
+            orderCounts.insert(orderCounts.begin() + index, 0);
+        }
+        quantities[index] = level->totalQty;
+        orderCounts[index] = static_cast<uint32_t>(level->orders.size());
+    }
+};
+
+// Immutable full-depth view. Chunk pointers are held best first on each side.
+class DepthSnapshot {
+    private:
+        uint64_t version;
+        std::vector<const DepthChunk*> bidChunks;
+        std::vector<const DepthChunk*> askChunks;
+        size_t bidLevels = 0;
+        size_t askLevels = 0;
+
+        template <typename Map>
+        static void collect(const Map &chunks, std::vector<const DepthChunk*> &out, size_t &levels, bool descending) {
+            out.reserve(chunks.size());
+            auto append = [&](const auto &entry) {
+                out.push_back(entry.second.get());
+                levels += entry.second->prices.size();
+            };
+            if (descending) std::for_each(chunks.rbegin(), chunks.rend(), append);
+            else std::for_each(chunks.begin(), chunks.end(), append);
+        }
+
+    public:
+        template <typename Map>
+        DepthSnapshot(uint64_t version_, const Map &bids, const Map &asks) : version(version_) {
+            collect(bids, bidChunks, bidLevels, true);
+            collect(asks, askChunks, askLevels, false);
+        }
+
+        inline uint64_t getVersion() const { return version; }
+        inline size_t levelCount(const Side side) const { return side == Side::Buy ? bidLevels : askLevels; }
+
+        // Visits levels best to worst until fn(price, qty, orderCount) returns false.
+        template <typename Fn>
+        void forEachLevel(const Side side, Fn &&fn) const {
+            if (side == Side::Buy) {
+                for (const DepthChunk* chunk : bidChunks) {
+                    for (size_t i = chunk->prices.size(); i-- > 0; ) {
+                        if (!fn(chunk->prices[i], chunk->quantities[i], chunk->orderCounts[i])) return;
+                    }
+                }
+            } else {
+                for (const DepthChunk* chunk : askChunks) {
+                    for (size_t i = 0; i < chunk->prices.size(); ++i) {
+                        if (!fn(chunk->prices[i], chunk->quantities[i], chunk->orderCounts[i])) return;
+                    }
+                }
+            }
+        }
+};
+
+// Publishes DepthSnapshots from the matching thread to any number of reader threads.
+// The publisher records level changes through the book's change log; publish() patches
+// only the chunks those changes fall in, then swaps the current snapshot pointer.
+// Replaced snapshots and chunks are retired with the epoch at which they stopped being
+// current and freed once every pinned reader has moved past that epoch.
+template <typename Book>
+class DepthPublisher {
+    public:
+        static constexpr size_t MAX_READERS = 64;
+
+        class ReadGuard {
+            private:
+                std::atomic<uint64_t>* slot;
+                const DepthSnapshot* snapshot;
+
+            public:
+                ReadGuard(std::atomic<uint64_t>* slot_, const DepthSnapshot* snapshot_) : slot(slot_), snapshot(snapshot_) {}
+                ReadGuard(const ReadGuard&) = delete;
+                ReadGuard& operator=(const ReadGuard&) = delete;
+                ~ReadGuard() { slot->store(0, std::memory_order_release); }
+
+                inline const DepthSnapshot& operator*() const { return *snapshot; }
+                inline const DepthSnapshot* operator->() const { return snapshot; }
+        };
+
+    private:
+        using ChunkMap = std::map<PriceTicks, std::unique_ptr<const DepthChunk>>;
+
+        struct alignas(64) ReaderSlot {
+            std::atomic<uint64_t> pinnedEpoch{0};   // 0 while the reader holds nothing
+        };
+
+        Book* book;
+        std::vector<LevelChange> changes;
+        ChunkMap bidChunks;
+        ChunkMap askChunks;
+
+        std::atomic<const DepthSnapshot*> current{nullptr};
+        std::atomic<uint64_t> epoch{1};
+        std::array<ReaderSlot, MAX_READERS> readers;
+        std::atomic<uint32_t> registeredReaders{0};
+
+        std::vector<std::pair<uint64_t, std::unique_ptr<const DepthChunk>>> retiredChunks;
+        std::vector<std::pair<uint64_t, std::unique_ptr<const DepthSnapshot>>> retiredSnapshots;
+        uint64_t version = 0;
+
+        void rebuildChunk(ChunkMap &chunks, Side side, PriceTicks key, const LevelChange* first, const LevelChange* last, uint64_t retireEpoch) {
+            auto it = chunks.find(key);
+            auto chunk = it == chunks.end() ? std::make_unique<DepthChunk>() : std::make_unique<DepthChunk>(*it->second);
+            for (const LevelChange* change = first; change != last; ++change) {
+                chunk->set(change->price, book->getLevel(side, change->price));
+            }
+            if (it != chunks.end()) {
+                retiredChunks.emplace_back(retireEpoch, std::move(it->second));
+            }
+            if (chunk->empty()) {
+                if (it != chunks.end()) chunks.erase(it);
+            } else if (it != chunks.end()) {
+                it->second = std::move(chunk);
+            } else {
+                chunks.emplace(key, std::move(chunk));
+            }
+        }
+
+        void reclaim() {
+            uint64_t oldestPinned = UINT64_MAX;
+            uint32_t count = std::min<uint32_t>(registeredReaders.load(std::memory_order_acquire), MAX_READERS);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint64_t pinned = readers[i].pinnedEpoch.load(std::memory_order_seq_cst);
+                if (pinned) oldestPinned = std::min(oldestPinned, pinned);
+            }
+            auto expired = [&](const auto &entry) { return entry.first <= oldestPinned; };
+            std::erase_if(retiredChunks, expired);
+            std::erase_if(retiredSnapshots, expired);
+        }
+
+    public:
+        explicit DepthPublisher(Book* book_) : book(book_) {
+            book->getBids().forEachLevel([&](PriceTicks price, const auto &) {
+                changes.push_back(LevelChange{Side::Buy, price});
+                return true;
+            });
+            book->getAsks().forEachLevel([&](PriceTicks price, const auto &) {
+                changes.push_back(LevelChange{Side::Sell, price});
+                return true;
+            });
+            book->setChangeLog(&changes);
+            publish();
+        }
+
+        DepthPublisher(const DepthPublisher&) = delete;
+        DepthPublisher& operator=(const DepthPublisher&) = delete;
+
+        ~DepthPublisher() {
+            book->setChangeLog(nullptr);
+            delete current.load();
+        }
+
+        // Writer side; call from the thread that mutates the book.
+        void publish() {
+            uint64_t retireEpoch = epoch.load(std::memory_order_relaxed) + 1;
+            std::sort(changes.begin(), changes.end(), [](const LevelChange &a, const LevelChange &b) {
+                if (a.side != b.side) return a.side < b.side;
+                return a.price < b.price;
+            });
+            for (size_t start = 0; start < changes.size(); ) {
+                Side side = changes[start].side;
+                PriceTicks key = DepthChunk::keyOf(changes[start].price);
+                size_t end = start + 1;
+                while (end < changes.size() && changes[end].side == side && DepthChunk::keyOf(changes[end].price) == key) ++end;
+                rebuildChunk(side == Side::Buy ? bidChunks : askChunks, side, key, &changes[start], &changes[end], retireEpoch);
+                start = end;
+            }
+            changes.clear();
+            const DepthSnapshot* previous = current.exchange(new DepthSnapshot(++version, bidChunks, askChunks), std::memory_order_seq_cst);
+            epoch.store(retireEpoch, std::memory_order_seq_cst);
+            if (previous) retiredSnapshots.emplace_back(retireEpoch, previous);
+            reclaim();
+        }
+
+        inline size_t pendingChanges() const { return changes.size(); }
+        inline size_t retiredCount() const { return retiredChunks.size() + retiredSnapshots.size(); }
+
+        // Reader side. Each reader thread registers once and uses its own ID.
+        std::optional<uint32_t> registerReader() {
+            uint32_t id = registeredReaders.fetch_add(1, std::memory_order_acq_rel);
+            if (id >= MAX_READERS) return std::nullopt;
+            return id;
+        }
+
+        // Pins the current epoch for the guard's lifetime; at most one guard per reader ID.
+        ReadGuard read(uint32_t readerID) {
+            std::atomic<uint64_t>& slot = readers[readerID].pinnedEpoch;
+            slot.store(epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            return ReadGuard(&slot, current.load(std::memory_order_seq_cst));
+        }
+};
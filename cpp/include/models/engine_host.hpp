@@ -0,0 +1,230 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include "models/matching_engine.hpp"
+#include "utils/huge_pages.hpp"
+#include "utils/spsc_ring.hpp"
+
+// What the matching thread does when the input ring is empty. Spin never leaves the core;
+// the other two spin for spinsBeforeBackoff empty polls first.
+enum class IdleWait : uint8_t {
+    Spin,
+    SpinThenYield,      // sched_yield per empty poll
+    SpinThenSleep       // sleeps from 1us, doubling up to maxSleep
+};
+
+struct EngineHostConfig {
+    int core = -1;                          // CPU for the matching thread; -1 leaves it unpinned
+    IdleWait idleWait = IdleWait::Spin;
+    uint32_t spinsBeforeBackoff = 4096;
+    std::chrono::microseconds maxSleep{100};
+    size_t ringCapacity = 1 << 16;
+    uint32_t warmupOrders = 100000;         // synthetic pre-open orders, 0 to skip
+    uint64_t warmupSeed = 1;
+    HugePageArena* arena = nullptr;         // prefaulted and installed on the matching thread only
+};
+
+struct EngineHostStats {
+    uint64_t commands = 0;
+    uint64_t warmupOrders = 0;
+    uint64_t emptyPolls = 0;
+    uint64_t backoffs = 0;
+    bool pinned = false;
+};
+
+template <typename Handle>
+struct EngineCommand {
+    enum class Kind : uint8_t { Submit, Cancel };
+
+    Kind kind = Kind::Submit;
+    Handle order = nullptr;
+};
+
+// Receives results on the matching thread. Fills are only valid during the call.
+struct NullEngineListener {
+    template <typename Handle, typename Fill>
+    void onSubmit(const Handle &, const MatchOutcome &, std::span<const Fill>) {}
+    template <typename Handle>
+    void onCancel(const Handle &, RejectionReason) {}
+};
+
+// Runs a matching engine on its own thread fed by a single-producer ring. start() pins the
+// thread, prefaults and installs the arena if one is configured, then replays a synthetic
+// pre-open flow through a scratch book and engine of the same types so the matching code
+// and allocator free lists are warm; the scratch state is discarded before the first real
+// command is taken. Commands are Submit (matchOrder) and Cancel (remove a resting order).
+// One producer thread calls submit/cancel; the listener runs on the matching thread.
+template <typename Book = LimitOrderBook, typename Listener = NullEngineListener>
+class EngineHost {
+    public:
+        using Engine = BasicMatchingEngine<Book>;
+        using BookOrder = typename Book::BookOrder;
+        using Handle = typename Book::Handle;
+        using Command = EngineCommand<Handle>;
+
+    private:
+        Book* book;
+        STPPolicy* stpPolicy;
+        typename Engine::Allocation* allocationPolicy;
+        Engine engine;
+        EngineHostConfig config;
+        Listener listener;
+        SpscRing<Command> ring;
+        std::thread worker;
+        std::atomic<bool> ready{false};
+        std::atomic<bool> stopping{false};
+        EngineHostStats stats;
+
+        static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        void execute(const Command &command) {
+            if (command.kind == Command::Kind::Submit) {
+                MatchOutcome outcome = engine.matchOrder(command.order);
+                listener.onSubmit(command.order, outcome, engine.getLastFills());
+            } else {
+                RejectionReason result = book->removeOrder(command.order->getOrderID());
+                if (result == RejectionReason::None) {
+                    command.order->setStatus(OrderLifecycle::afterCancelResting(command.order->getStatus()));
+                    engine.publishTopOfBook();
+                }
+                listener.onCancel(command.order, result);
+            }
+            ++stats.commands;
+        }
+
+        // Limit orders within 20 ticks of a mid, a tenth of them marketable by price and a
+        // tenth market orders, with a fifth of submissions followed by a cancel.
+        void warmUp() {
+            if (config.warmupOrders == 0) return;
+            const InstrumentSpec* instrument = book->getInstrumentSpec();
+            PriceTicks mid = instrument ? (instrument->getPriceBand().low + instrument->getPriceBand().high) / 2 : 10000;
+            Book scratchBook(instrument);
+            Engine scratchEngine(stpPolicy, &scratchBook, allocationPolicy);
+            std::deque<BookOrder> orders;
+            std::mt19937_64 rng(config.warmupSeed);
+            std::uniform_int_distribution<int> offset(1, 20);
+            std::uniform_int_distribution<int> qty(1, 100);
+            std::uniform_int_distribution<int> percent(0, 99);
+            for (uint32_t i = 1; i <= config.warmupOrders; ++i) {
+                Side side = i % 2 ? Side::Buy : Side::Sell;
+                int roll = percent(rng);
+                OrderType type = roll < 10 ? OrderType::Market : OrderType::Limit;
+                PriceTicks distance = roll < 20 ? -offset(rng) : offset(rng);
+                PriceTicks price = type == OrderType::Market ? 0 : (side == Side::Buy ? mid - distance : mid + distance);
+                BookOrder& order = orders.emplace_back(i, i % 64, price, qty(rng), side, type, i);
+                MatchOutcome outcome = scratchEngine.matchOrder(&order);
+                if (outcome && outcome->resting && percent(rng) < 20) {
+                    scratchBook.removeOrder(order.getOrderID());
+                }
+            }
+            stats.warmupOrders = config.warmupOrders;
+        }
+
+        void backOff(uint32_t &idle, std::chrono::microseconds &sleep) {
+            ++stats.emptyPolls;
+            if (config.idleWait == IdleWait::Spin || ++idle < config.spinsBeforeBackoff) {
+                cpuRelax();
+                return;
+            }
+            ++stats.backoffs;
+            if (config.idleWait == IdleWait::SpinThenYield) {
+                std::this_thread::yield();
+                return;
+            }
+            std::this_thread::sleep_for(sleep);
+            sleep = std::min(sleep * 2, config.maxSleep);
+        }
+
+        void run() {
+            if (config.core >= 0) stats.pinned = pinCurrentThread(config.core);
+            if (config.arena) {
+                config.arena->prefault();
+                HugePageArena::install(config.arena);
+            }
+            warmUp();
+            ready.store(true, std::memory_order_release);
+
+            uint32_t idle = 0;
+            std::chrono::microseconds sleep{1};
+            auto handle = [this](const Command &command) { execute(command); };
+            while (true) {
+                if (ring.drain(handle, 256) != 0) {
+                    idle = 0;
+                    sleep = std::chrono::microseconds{1};
+                    continue;
+                }
+                if (stopping.load(std::memory_order_acquire) && ring.empty()) break;
+                backOff(idle, sleep);
+            }
+        }
+
+    public:
+        EngineHost(Book* book_, STPPolicy* policy, EngineHostConfig config_ = {},
+                   Listener listener_ = {}, typename Engine::Allocation* allocation = nullptr)
+            : book(book_), stpPolicy(policy), allocationPolicy(allocation), engine(policy, book_, allocation),
+              config(config_), listener(std::move(listener_)), ring(config_.ringCapacity) {}
+
+        EngineHost(const EngineHost&) = delete;
+        EngineHost& operator=(const EngineHost&) = delete;
+
+        ~EngineHost() { stop(); }
+
+        // Returns false if the calling thread could not be bound to core.
+        static bool pinCurrentThread(int core) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(core, &cpus);
+            return ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus) == 0;
+        }
+
+        inline Engine& getEngine() { return engine; }
+        inline Listener& getListener() { return listener; }
+
+        // Each start is a fresh run: stats restart from zero and waitUntilReady waits for this
+        // run's warm-up.
+        void start() {
+            if (worker.joinable()) return;
+            stopping.store(false, std::memory_order_relaxed);
+            ready.store(false, std::memory_order_relaxed);
+            stats = EngineHostStats{};
+            worker = std::thread([this] { run(); });
+        }
+
+        // Spins until warm-up is done and the ring is being polled.
+        void waitUntilReady() const {
+            while (!ready.load(std::memory_order_acquire)) std::this_thread::yield();
+        }
+
+        // Producer side. False when the ring is full.
+        inline bool trySubmit(const Handle &order) { return ring.tryPush(Command{Command::Kind::Submit, order}); }
+        inline bool tryCancel(const Handle &order) { return ring.tryPush(Command{Command::Kind::Cancel, order}); }
+
+        void submit(const Handle &order) {
+            while (!trySubmit(order)) cpuRelax();
+        }
+
+        void cancel(const Handle &order) {
+            while (!tryCancel(order)) cpuRelax();
+        }
+
+        // Processes every queued command, then joins the matching thread.
+        void stop() {
+            if (!worker.joinable()) return;
+            stopping.store(true, std::memory_order_release);
+            worker.join();
+        }
+
+        // Stable after stop().
+        inline const EngineHostStats& getStats() const { return stats; }
+};
@@ -0,0 +1,274 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <thread>
+#include <vector>
+#include "models/fill.hpp"
+#include "utils/spsc_ring.hpp"
+
+enum class TapeEventKind : uint8_t { Fill = 0, Accepted = 1, Cancelled = 2 };
+
+enum class TapeError : uint8_t {
+    None,                   // tape decoded
+    Truncated,              // buffer ends inside a header or column
+    BadMagic,               // buffer is not an event tape
+    UnsupportedVersion,     // written with a different column layout
+    CorruptColumn           // a column does not decode to the declared row count
+};
+
+// One tape row. For fills orderID is the taker and otherOrderID the maker; for order
+// events otherOrderID is 0.
+struct TapeRecord {
+    Timestamp timestamp = 0;
+    PriceTicks price = 0;
+    OrderID orderID = 0;
+    OrderID otherOrderID = 0;
+    OwnerID ownerID = 0;
+    Quantity qty = 0;
+    TapeEventKind kind = TapeEventKind::Fill;
+    Side side = Side::Buy;
+
+    bool operator==(const TapeRecord&) const = default;
+
+    static TapeRecord fromFill(const Fill &fill) {
+        return TapeRecord{fill.timestamp, fill.price, fill.takerOrderID, fill.makerOrderID, fill.takerOwnerID, fill.qty, TapeEventKind::Fill, fill.takerSide};
+    }
+
+    static TapeRecord fromOrder(TapeEventKind kind, const Order &order) {
+        return TapeRecord{order.getTimestamp(), order.getPriceTicks(), order.getOrderID(), 0, order.getOwnerID(), order.getQty(), kind, order.getSide()};
+    }
+};
+
+// Tape layout, host-endian: a 16-byte TapeHeader, then chunks. Each chunk is a
+// TapeChunkHeader followed by its columns in TapeColumn order. Integer columns hold
+// zigzag LEB128 varints of the difference from the previous row in the same chunk (the
+// first row against 0), so every chunk decodes on its own. The flags column is one raw
+// byte per row: kind in the low nibble, side in the high one.
+struct TapeHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t columnCount;
+    uint64_t reserved;
+};
+
+enum TapeColumn : size_t { Timestamps, Prices, OrderIDs, OtherOrderIDs, OwnerIDs, Quantities, Flags, COLUMN_COUNT };
+
+struct TapeChunkHeader {
+    uint32_t magic;
+    uint32_t rowCount;
+    std::array<uint32_t, COLUMN_COUNT> columnBytes;
+};
+
+static_assert(sizeof(TapeHeader) == 16);
+
+class TapeCodec {
+    public:
+        static constexpr uint32_t MAGIC = 0x5041544C;          // "LTAP"
+        static constexpr uint32_t CHUNK_MAGIC = 0x4B48434C;    // "LCHK"
+        static constexpr uint16_t VERSION = 1;
+
+        static inline uint64_t zigzag(int64_t value) {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        static inline int64_t unzigzag(uint64_t value) {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        static inline void putVarint(std::vector<uint8_t> &out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        // Returns false if the varint runs past end or is longer than ten bytes.
+        static inline bool getVarint(const uint8_t* &in, const uint8_t* end, uint64_t &value) {
+            value = 0;
+            for (unsigned shift = 0; shift < 70 && in < end; shift += 7) {
+                uint8_t byte = *in++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+};
+
+// Accumulates rows into per-column delta/varint buffers and emits whole chunks.
+class TapeChunkEncoder {
+    private:
+        std::array<std::vector<uint8_t>, COLUMN_COUNT> columns;
+        std::array<int64_t, COLUMN_COUNT> previous{};
+        uint32_t rows = 0;
+
+        inline void putDelta(TapeColumn column, int64_t value) {
+            TapeCodec::putVarint(columns[column], TapeCodec::zigzag(value - previous[column]));
+            previous[column] = value;
+        }
+
+    public:
+        inline uint32_t rowCount() const { return rows; }
+
+        void add(const TapeRecord &record) {
+            putDelta(Timestamps, static_cast<int64_t>(record.timestamp));
+            putDelta(Prices, record.price);
+            putDelta(OrderIDs, record.orderID);
+            putDelta(OtherOrderIDs, record.otherOrderID);
+            putDelta(OwnerIDs, record.ownerID);
+            putDelta(Quantities, record.qty);
+            columns[Flags].push_back(static_cast<uint8_t>(static_cast<uint8_t>(record.kind) | static_cast<uint8_t>(record.side) << 4));
+            ++rows;
+        }
+
+        void flush(std::ostream &out) {
+            if (rows == 0) return;
+            TapeChunkHeader header{TapeCodec::CHUNK_MAGIC, rows, {}};
+            for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+                header.columnBytes[c] = static_cast<uint32_t>(columns[c].size());
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (auto& column : columns) {
+                out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(column.size()));
+                column.clear();
+            }
+            previous = {};
+            rows = 0;
+        }
+};
+
+// Records are handed to a background thread through an SPSC ring; that thread encodes
+// chunks of chunkRows rows and writes them to out. append() only stalls if the ring is
+// full, and each stall is counted. One producer thread may append; close() (or the
+// destructor) drains the ring, writes the last partial chunk and joins the thread.
+class TapeWriter {
+    private:
+        SpscRing<TapeRecord> ring;
+        std::ostream& out;
+        uint32_t chunkRows;
+        std::atomic<bool> stopping{false};
+        std::atomic<uint64_t> written{0};
+        uint64_t appended = 0;
+        uint64_t stalls = 0;
+        std::thread worker;
+
+        void run() {
+            TapeChunkEncoder encoder;
+            auto encode = [&](const TapeRecord &record) {
+                encoder.add(record);
+                if (encoder.rowCount() == chunkRows) encoder.flush(out);
+            };
+            while (true) {
+                size_t count = ring.drain(encode, chunkRows);
+                written.fetch_add(count, std::memory_order_relaxed);
+                if (count == 0) {
+                    if (stopping.load(std::memory_order_acquire) && ring.empty()) break;
+                    std::this_thread::yield();
+                }
+            }
+            encoder.flush(out);
+            out.flush();
+        }
+
+    public:
+        TapeWriter(std::ostream &out_, size_t ringCapacity = 1 << 16, uint32_t chunkRows_ = 4096)
+            : ring(ringCapacity), out(out_), chunkRows(chunkRows_) {
+            TapeHeader header{TapeCodec::MAGIC, TapeCodec::VERSION, COLUMN_COUNT, 0};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            worker = std::thread([this] { run(); });
+        }
+
+        TapeWriter(const TapeWriter&) = delete;
+        TapeWriter& operator=(const TapeWriter&) = delete;
+
+        ~TapeWriter() { close(); }
+
+        void append(const TapeRecord &record) {
+            if (!ring.tryPush(record)) {
+                ++stalls;
+                while (!ring.tryPush(record)) std::this_thread::yield();
+            }
+            ++appended;
+        }
+
+        void appendFills(std::span<const Fill> fills) {
+            for (const Fill& fill : fills) append(TapeRecord::fromFill(fill));
+        }
+
+        void close() {
+            if (!worker.joinable()) return;
+            stopping.store(true, std::memory_order_release);
+            worker.join();
+        }
+
+        inline uint64_t getAppendedCount() const { return appended; }
+        inline uint64_t getWrittenCount() const { return written.load(std::memory_order_relaxed); }
+        inline uint64_t getStallCount() const { return stalls; }
+};
+
+class TapeReader {
+    private:
+        static bool decodeColumn(std::span<const uint8_t> bytes, uint32_t rows, std::vector<int64_t> &values) {
+            values.resize(rows);
+            const uint8_t* in = bytes.data();
+            const uint8_t* end = in + bytes.size();
+            int64_t previous = 0;
+            for (uint32_t row = 0; row < rows; ++row) {
+                uint64_t raw;
+                if (!TapeCodec::getVarint(in, end, raw)) return false;
+                previous += TapeCodec::unzigzag(raw);
+                values[row] = previous;
+            }
+            return in == end;
+        }
+
+    public:
+        // Appends every row of the tape to records; on error records holds the rows of
+        // the chunks decoded before the bad one.
+        static TapeError read(std::span<const std::byte> data, std::vector<TapeRecord> &records) {
+            TapeHeader header;
+            if (data.size() < sizeof(header)) return TapeError::Truncated;
+            std::memcpy(&header, data.data(), sizeof(header));
+            if (header.magic != TapeCodec::MAGIC) return TapeError::BadMagic;
+            if (header.version != TapeCodec::VERSION || header.columnCount != COLUMN_COUNT) return TapeError::UnsupportedVersion;
+
+            size_t offset = sizeof(header);
+            std::array<std::vector<int64_t>, COLUMN_COUNT> values;
+            while (offset < data.size()) {
+                TapeChunkHeader chunk;
+                if (data.size() - offset < sizeof(chunk)) return TapeError::Truncated;
+                std::memcpy(&chunk, data.data() + offset, sizeof(chunk));
+                if (chunk.magic != TapeCodec::CHUNK_MAGIC) return TapeError::BadMagic;
+                offset += sizeof(chunk);
+                const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+                for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+                    if (data.size() - offset < chunk.columnBytes[c]) return TapeError::Truncated;
+                    std::span<const uint8_t> column(bytes + offset, chunk.columnBytes[c]);
+                    offset += chunk.columnBytes[c];
+                    if (c == Flags) {
+                        if (column.size() != chunk.rowCount) return TapeError::CorruptColumn;
+                        values[c].assign(column.begin(), column.end());
+                    } else if (!decodeColumn(column, chunk.rowCount, values[c])) {
+                        return TapeError::CorruptColumn;
+                    }
+                }
+                for (uint32_t row = 0; row < chunk.rowCount; ++row) {
+                    uint8_t flags = static_cast<uint8_t>(values[Flags][row]);
+                    records.push_back(TapeRecord{
+                        static_cast<Timestamp>(values[Timestamps][row]),
+                        values[Prices][row],
+                        static_cast<OrderID>(values[OrderIDs][row]),
+                        static_cast<OrderID>(values[OtherOrderIDs][row]),
+                        static_cast<OwnerID>(values[OwnerIDs][row]),
+                        static_cast<Quantity>(values[Quantities][row]),
+                        static_cast<TapeEventKind>(flags & 0x0F),
+                        static_cast<Side>(flags >> 4)
+                    });
+                }
+            }
+            return TapeError::None;
+        }
+};
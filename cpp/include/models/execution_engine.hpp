@@ -4,8 +4,9 @@
 
 class ExecutionEngine {
 public:
-    static Quantity executeTrade(const OrderPtr& taker, const OrderPtr& maker) {
-        Quantity tradedQty = std::min(taker->getQty(), maker->getQty());
+    template <typename OrderT>
+    static Quantity executeTrade(OrderT* const& taker, OrderT* const& maker) {
+        Quantity tradedQty = std::min<Quantity>(taker->getQty(), maker->getQty());
         taker->reduceQty(tradedQty);
         maker->reduceQty(tradedQty);
         return tradedQty;
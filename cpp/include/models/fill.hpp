@@ -0,0 +1,18 @@
+#pragma once
+#include "models/order.hpp"
+
+// One execution between two orders. In continuous matching the taker is the incoming
+// order and price is the maker's; in an auction uncross the buy order is recorded as taker.
+template <typename OrderT>
+struct BasicFill {
+    typename OrderT::ID takerOrderID;
+    typename OrderT::ID makerOrderID;
+    typename OrderT::Owner takerOwnerID;
+    typename OrderT::Owner makerOwnerID;
+    PriceTicks price;
+    Quantity qty;
+    Side takerSide;
+    typename OrderT::Time timestamp;
+};
+
+using Fill = BasicFill<Order>;
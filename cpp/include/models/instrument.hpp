@@ -0,0 +1,66 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "models/order.hpp"
+
+// Prices are whole ticks of the instrument's finest increment. A tier makes every
+// increment-th tick valid from its starting price up to the next tier.
+struct TickTier {
+    PriceTicks fromPrice;
+    PriceTicks increment;
+};
+
+class TickLadder {
+    private:
+        std::vector<TickTier> tiers;
+
+    public:
+        TickLadder() : tiers{{1, 1}} {}
+
+        // Tiers must be strictly ascending by fromPrice with positive increments; anything
+        // else throws std::invalid_argument, since isValidPrice divides by the increment.
+        explicit TickLadder(std::vector<TickTier> tiers_) : tiers(std::move(tiers_)) {
+            for (size_t i = 0; i < tiers.size(); ++i) {
+                if (tiers[i].increment <= 0 || (i != 0 && tiers[i].fromPrice <= tiers[i - 1].fromPrice)) {
+                    throw std::invalid_argument("TickLadder tiers must ascend with positive increments");
+                }
+            }
+        }
+
+        bool isValidPrice(PriceTicks price) const {
+            auto tier = std::upper_bound(tiers.begin(), tiers.end(), price,
+                [](PriceTicks p, const TickTier &t) { return p < t.fromPrice; });
+            if (tier == tiers.begin()) return false;
+            --tier;
+            return (price - tier->fromPrice) % tier->increment == 0;
+        }
+
+        const std::vector<TickTier>& getTiers() const { return tiers; }
+};
+
+struct PriceBand {
+    PriceTicks low;
+    PriceTicks high;
+
+    bool contains(PriceTicks price) const { return price >= low && price <= high; }
+    PriceTicks width() const { return high - low + 1; }
+
+    static PriceBand aroundReference(PriceTicks referencePrice, uint32_t collarBasisPoints) {
+        PriceTicks offset = referencePrice * collarBasisPoints / 10000;
+        return PriceBand{std::max<PriceTicks>(1, referencePrice - offset), referencePrice + offset};
+    }
+};
+
+class InstrumentSpec {
+    private:
+        TickLadder ladder;
+        PriceBand band;
+
+    public:
+        InstrumentSpec(TickLadder ladder_, PriceBand band_) : ladder(std::move(ladder_)), band(band_) {}
+
+        inline const TickLadder& getTickLadder() const { return ladder; }
+        inline const PriceBand& getPriceBand() const { return band; }
+        inline void setPriceBand(PriceBand newBand) { band = newBand; }
+};
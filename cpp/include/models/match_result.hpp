@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <expected>
+#include <type_traits>
+#include "models/order.hpp"
+#include "policy/order_validation.hpp"
+
+// Outcome of one matchOrder call. Fills [firstFill, firstFill + fillCount) of the engine's
+// getLastFills() belong to this call. restRejection is set when the unfilled remainder
+// could not be added to the book; the order is then cancelled rather than left dangling.
+struct MatchResult {
+    OrderStatus finalStatus = OrderStatus::Pending;
+    Quantity filledQty = 0;
+    int64_t notional = 0;           // sum of price * qty over the fills, in ticks
+    uint32_t firstFill = 0;
+    uint32_t fillCount = 0;
+    bool resting = false;
+    RejectionReason restRejection = RejectionReason::None;
+    OrderHandle handle;             // the resting remainder's book handle; null unless resting
+
+    double averagePrice() const { return filledQty ? static_cast<double>(notional) / filledQty : 0.0; }
+};
+
+static_assert(std::is_trivially_copyable_v<MatchResult>);
+
+// Unexpected when the order was refused before touching the book.
+using MatchOutcome = std::expected<MatchResult, RejectionReason>;
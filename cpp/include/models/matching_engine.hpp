@@ -1,36 +1,68 @@
 #pragma once
 #include "models/order_book.hpp"
+#include "models/auction.hpp"
 #include "models/execution_engine.hpp"
+#include "models/fill.hpp"
+#include "models/match_result.hpp"
+#include "models/top_of_book.hpp"
+#include "policy/allocation_policy.hpp"
 #include "policy/order_lifecycle.hpp"
 #include "policy/self_trade_prevention.hpp"
 #include "utils/order_utils.hpp"
 
-class MatchingEngine {
+enum class TradingPhase : uint8_t { Continuous = 0, Auction = 1 };
+
+template <typename Book>
+class BasicMatchingEngine {
+    public:
+        using BookOrder = typename Book::BookOrder;
+        using Handle = typename Book::Handle;
+        using Level = typename Book::Level;
+        using EngineFill = BasicFill<BookOrder>;
+        using Allocation = BasicAllocationPolicy<BookOrder>;
+
     private:
-        LimitOrderBook* orderBook;
+        Book* orderBook;
         STPPolicy* stpPolicy;
+        Allocation* allocationPolicy;
+        TradingPhase phase = TradingPhase::Continuous;
+        std::vector<EngineFill> fills;
+        std::vector<Quantity> allocationScratch;
+        std::vector<DepthPoint> bidDepth;
+        std::vector<DepthPoint> askDepth;
+        TopOfBookFeed* topOfBookFeed = nullptr;
+        uint64_t eventSequence = 0;
 
-    public:
-        explicit MatchingEngine(STPPolicy* policy, LimitOrderBook* book)
-            : stpPolicy(policy), orderBook(book) {}
+        void recordFill(const Handle &taker, const Handle &maker, Quantity qty, PriceTicks price, Timestamp timestamp) {
+            fills.push_back(EngineFill{
+                taker->getOrderID(), maker->getOrderID(), taker->getOwnerID(), maker->getOwnerID(),
+                price, qty, taker->getSide(), timestamp
+            });
+        }
 
-        void applySTPPolicy(const OrderPtr &restingOrder, const OrderPtr &incomingOrder, const Quantity incomingInitialQty) {
-            STPDecision decision = stpPolicy->getDecision();
-            if (decision.cancelIncoming) {
-                incomingOrder->setStatus(
-                    OrderLifecycle::afterCancelIncoming(incomingInitialQty, incomingOrder->getQty())
-                );
-            }
-            if (decision.cancelResting) {
-                restingOrder->setStatus(
-                    OrderLifecycle::afterCancelResting(restingOrder->getStatus())
-                );
-                orderBook->popFront(incomingOrder->getSide());
+        template <typename Levels>
+        static void collectDepth(const Levels &levels, std::vector<DepthPoint> &depth) {
+            depth.clear();
+            levels.forEachLevel([&](PriceTicks price, const Level &level) {
+                depth.push_back(DepthPoint{price, level.totalQty});
+                return true;
+            });
+        }
+
+        // Pulls qty off the head of one side; side is the side being consumed.
+        void fillHead(const Side side, const Handle &order, Quantity qty) {
+            Side aggressorSide = side == Side::Buy ? Side::Sell : Side::Buy;
+            Quantity initialQty = order->getQty();
+            order->reduceQty(qty);
+            orderBook->reduceBestLevelQty(aggressorSide, qty);
+            order->setStatus(OrderLifecycle::afterMatching(initialQty, order->getQty(), OrderType::Limit));
+            if (order->getQty() == 0) {
+                orderBook->popFront(aggressorSide);
             }
         }
 
-        void matchOrder(const OrderPtr &incomingOrder) {
-            Quantity incomingInitialQty = incomingOrder->getQty();
+        // Price-time FIFO straight off the queue head. Returns false if STP cancelled the incoming order.
+        bool matchFifo(const Handle &incomingOrder, const Quantity incomingInitialQty) {
             Side incomingSide = incomingOrder->getSide();
             while (orderBook->isOrderMarketable(incomingOrder)) {
                 auto restingOrder = orderBook->getMatchedOrder(incomingSide);
@@ -38,13 +70,15 @@ class MatchingEngine {
                 if (isSelfTrade(restingOrder, incomingOrder)) {
                     applySTPPolicy(restingOrder, incomingOrder, incomingInitialQty);
                     if (incomingOrder->isCancelled()) {
-                        return;
+                        return false;
                     }
                     if (restingOrder->isCancelled()) {
                         continue;
                     }
                 }
-                ExecutionEngine::executeTrade(incomingOrder, restingOrder);
+                Quantity tradedQty = ExecutionEngine::executeTrade(incomingOrder, restingOrder);
+                orderBook->reduceBestLevelQty(incomingSide, tradedQty);
+                recordFill(incomingOrder, restingOrder, tradedQty, restingOrder->getPriceTicks(), incomingOrder->getTimestamp());
                 restingOrder->setStatus(
                     OrderLifecycle::afterMatching(restingInitialQty, restingOrder->getQty(), OrderType::Limit)
                 );
@@ -52,10 +86,191 @@ class MatchingEngine {
                     orderBook->popFront(incomingSide);
                 }
             }
+            return true;
+        }
+
+        // Level-at-a-time matching for non-FIFO allocation. STP applies to the self-trade orders
+        // the policy would fill; once any is cancelled the level is allocated again, so the
+        // policy only ever fills eligible orders and untouched same-owner orders are left alone.
+        // A decision that cancels neither side lets the trade go ahead, as in matchFifo. The
+        // level's queue is walked in place; the next node is taken before an eviction, and a
+        // count bounds each walk because evicting the last order erases the level.
+        bool matchByAllocation(const Handle &incomingOrder, const Quantity incomingInitialQty) {
+            Side incomingSide = incomingOrder->getSide();
+            while (orderBook->isOrderMarketable(incomingOrder)) {
+                const Level* level = orderBook->getBestLevel(incomingSide);
+                size_t queued = level->orders.size();
+                allocationScratch.resize(queued);
+                allocationPolicy->allocate(*level, incomingOrder->getQty(), allocationScratch);
+
+                bool cancelledResting = false;
+                auto it = level->orders.begin();
+                for (size_t i = 0; i < queued; ++i) {
+                    Handle restingOrder = *it++;
+                    if (allocationScratch[i] <= 0 || !isSelfTrade(restingOrder, incomingOrder)) continue;
+                    STPDecision decision = stpPolicy->getDecision();
+                    if (decision.cancelResting) {
+                        restingOrder->setStatus(OrderLifecycle::afterCancelResting(restingOrder->getStatus()));
+                        orderBook->evictOrder(restingOrder->getOrderID());
+                        cancelledResting = true;
+                    }
+                    if (decision.cancelIncoming) {
+                        incomingOrder->setStatus(
+                            OrderLifecycle::afterCancelIncoming(incomingInitialQty, incomingOrder->getQty())
+                        );
+                        return false;
+                    }
+                }
+                if (cancelledResting) {
+                    continue;
+                }
+
+                it = level->orders.begin();
+                for (size_t i = 0; i < queued; ++i) {
+                    Handle restingOrder = *it++;
+                    Quantity allocated = allocationScratch[i];
+                    if (allocated <= 0) continue;
+                    Quantity restingInitialQty = restingOrder->getQty();
+                    incomingOrder->reduceQty(allocated);
+                    restingOrder->reduceQty(allocated);
+                    orderBook->reduceRestingQty(restingOrder, allocated);
+                    recordFill(incomingOrder, restingOrder, allocated, restingOrder->getPriceTicks(), incomingOrder->getTimestamp());
+                    restingOrder->setStatus(
+                        OrderLifecycle::afterMatching(restingInitialQty, restingOrder->getQty(), OrderType::Limit)
+                    );
+                    if (restingOrder->getQty() == 0) {
+                        orderBook->evictOrder(restingOrder->getOrderID());
+                    }
+                }
+            }
+            return true;
+        }
+
+        MatchResult summarise(const Handle &incomingOrder) const {
+            MatchResult result;
+            result.finalStatus = incomingOrder->getStatus();
+            result.fillCount = static_cast<uint32_t>(fills.size());
+            for (const EngineFill& fill : fills) {
+                result.filledQty += fill.qty;
+                result.notional += fill.price * fill.qty;
+            }
+            return result;
+        }
+
+        // Rests the remainder, or cancels it if the book refuses it.
+        MatchResult rest(const Handle &incomingOrder, const Quantity incomingInitialQty) {
+            OrderHandle handle;
+            RejectionReason addResult = orderBook->addOrder(incomingOrder, &handle);
+            if (addResult != RejectionReason::None) {
+                incomingOrder->setStatus(OrderLifecycle::afterCancelIncoming(incomingInitialQty, incomingOrder->getQty()));
+            }
+            MatchResult result = summarise(incomingOrder);
+            result.handle = handle;
+            result.resting = addResult == RejectionReason::None;
+            result.restRejection = addResult;
+            return result;
+        }
+
+        MatchOutcome processOrder(const Handle &incomingOrder) {
+            fills.clear();
+            RejectionReason priceCheck = OrderValidator::validatePrice(incomingOrder, orderBook->getInstrumentSpec());
+            if (priceCheck != RejectionReason::None) {
+                incomingOrder->setStatus(OrderStatus::Cancelled);
+                return std::unexpected(priceCheck);
+            }
+            Quantity incomingInitialQty = incomingOrder->getQty();
+            if (phase == TradingPhase::Auction) {
+                // Call phase: limit orders rest without matching; market orders have no price to rest at.
+                if (incomingOrder->getType() == OrderType::Market) {
+                    incomingOrder->setStatus(OrderStatus::Cancelled);
+                    return summarise(incomingOrder);
+                }
+                return rest(incomingOrder, incomingInitialQty);
+            }
+            bool stillLive = allocationPolicy
+                ? matchByAllocation(incomingOrder, incomingInitialQty)
+                : matchFifo(incomingOrder, incomingInitialQty);
+            if (!stillLive) {
+                return summarise(incomingOrder);
+            }
             OrderStatus finalStatus = OrderLifecycle::afterMatching(incomingInitialQty, incomingOrder->getQty(), incomingOrder->getType());
             incomingOrder->setStatus(finalStatus);
             if (finalStatus == OrderStatus::Pending || finalStatus == OrderStatus::PartiallyExecuted) {
-                orderBook->addOrder(incomingOrder);
+                return rest(incomingOrder, incomingInitialQty);
             }
+            return summarise(incomingOrder);
         }
-};
\ No newline at end of file
+
+    public:
+        // allocation == nullptr keeps the default price-time FIFO path.
+        explicit BasicMatchingEngine(STPPolicy* policy, Book* book, Allocation* allocation = nullptr)
+            : orderBook(book), stpPolicy(policy), allocationPolicy(allocation) {}
+
+        inline TradingPhase getTradingPhase() const { return phase; }
+        inline void setTradingPhase(TradingPhase newPhase) { phase = newPhase; }
+
+        // Fills produced by the most recent matchOrder or uncross call, in execution order.
+        inline std::span<const EngineFill> getLastFills() const { return fills; }
+
+        void applySTPPolicy(const Handle &restingOrder, const Handle &incomingOrder, const Quantity incomingInitialQty) {
+            STPDecision decision = stpPolicy->getDecision();
+            if (decision.cancelIncoming) {
+                incomingOrder->setStatus(
+                    OrderLifecycle::afterCancelIncoming(incomingInitialQty, incomingOrder->getQty())
+                );
+            }
+            if (decision.cancelResting) {
+                restingOrder->setStatus(
+                    OrderLifecycle::afterCancelResting(restingOrder->getStatus())
+                );
+                orderBook->popFront(incomingOrder->getSide());
+            }
+        }
+
+        // Publishes the top of book after every matchOrder and uncross once set. Callers that
+        // change the book directly (cancels) call publishTopOfBook themselves.
+        inline void setTopOfBookFeed(TopOfBookFeed* feed) { topOfBookFeed = feed; }
+
+        void publishTopOfBook() {
+            ++eventSequence;
+            if (topOfBookFeed) {
+                topOfBookFeed->store(TopOfBook::capture(*orderBook, eventSequence));
+            }
+        }
+
+        MatchOutcome matchOrder(const Handle &incomingOrder) {
+            MatchOutcome outcome = processOrder(incomingOrder);
+            publishTopOfBook();
+            return outcome;
+        }
+
+        // Executes the call auction at the volume-maximising price. Bids priced at or above it and
+        // asks at or below it trade in price-time priority until the executable volume is done;
+        // self-trade prevention is not applied. Returns nullopt when the book does not cross.
+        std::optional<AuctionEquilibrium> uncross(Timestamp timestamp) {
+            fills.clear();
+            collectDepth(orderBook->getBids(), bidDepth);
+            collectDepth(orderBook->getAsks(), askDepth);
+            std::optional<AuctionEquilibrium> equilibrium = AuctionUncross::findEquilibrium(bidDepth, askDepth);
+            if (!equilibrium) {
+                return std::nullopt;
+            }
+            int64_t remaining = equilibrium->volume;
+            while (remaining > 0) {
+                Handle bid = orderBook->getMatchedOrder(Side::Sell);
+                Handle ask = orderBook->getMatchedOrder(Side::Buy);
+                Quantity qty = static_cast<Quantity>(std::min<int64_t>({bid->getQty(), ask->getQty(), remaining}));
+                recordFill(bid, ask, qty, equilibrium->price, timestamp);
+                fillHead(Side::Buy, bid, qty);
+                fillHead(Side::Sell, ask, qty);
+                remaining -= qty;
+            }
+            publishTopOfBook();
+            return equilibrium;
+        }
+};
+
+using MatchingEngine = BasicMatchingEngine<LimitOrderBook>;
+
+template <typename Traits>
+using MatchingEngineFor = BasicMatchingEngine<LimitOrderBookFor<Traits>>;
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 
 using PriceTicks = int64_t;
 using Timestamp = uint64_t;
@@ -11,49 +13,125 @@ enum class Side : uint8_t { Buy = 0, Sell = 1 };
 enum class OrderType : uint8_t { Limit = 0, Market = 1 };
 enum class OrderStatus : uint16_t { Pending = 0, PartiallyExecuted = 1, Executed = 2, Cancelled = 3, CancelledAfterPartialExecution = 4 };
 
-class Order {
+// Integer widths of an order. Price and quantity must fit PriceTicks and Quantity, which
+// the book and engine use for aggregates and results; IDs and owners may be wider.
+struct DefaultOrderTraits {
+    using Price = PriceTicks;
+    using Qty = Quantity;
+    using ID = OrderID;
+    using Owner = OwnerID;
+    using Time = Timestamp;
+    static constexpr size_t alignment = 32;
+};
+
+// Narrow price range and lot sizes: 24 bytes per order.
+struct CompactOrderTraits {
+    using Price = int32_t;
+    using Qty = int16_t;
+    using ID = uint32_t;
+    using Owner = uint16_t;
+    using Time = uint64_t;
+    static constexpr size_t alignment = 8;
+};
+
+// Order IDs that do not fit 32 bits.
+struct WideIDOrderTraits {
+    using Price = PriceTicks;
+    using Qty = Quantity;
+    using ID = uint64_t;
+    using Owner = OwnerID;
+    using Time = Timestamp;
+    static constexpr size_t alignment = 8;
+};
+
+// Allocator the book uses for its level queues, level containers and order index. Traits
+// may name one as a member template Allocator<U>; otherwise it is std::allocator.
+template <typename Traits, typename U>
+struct TraitsAllocator {
+    using type = std::allocator<U>;
+};
+
+template <typename Traits, typename U>
+    requires requires { typename Traits::template Allocator<U>; }
+struct TraitsAllocator<Traits, U> {
+    using type = typename Traits::template Allocator<U>;
+};
+
+// Fields read by the matching loop (price, qty, owner, status, side, type) come first; ID
+// and timestamp follow. With the default traits that is the first 20 bytes, and aligning
+// to 32 bytes packs exactly two orders per cache line with none straddling two lines.
+template <typename T>
+class alignas(T::alignment) BasicOrder {
+    public:
+        using Traits = T;
+        using Price = typename T::Price;
+        using Qty = typename T::Qty;
+        using ID = typename T::ID;
+        using Owner = typename T::Owner;
+        using Time = typename T::Time;
+
+        static_assert(sizeof(Price) <= sizeof(PriceTicks) && sizeof(Qty) <= sizeof(Quantity));
+
     private:
-        PriceTicks priceTicks;
-        Timestamp timestamp;
-        OrderID orderID;
-        OwnerID ownerID;
-        Quantity qty;
-        Side  side;
-        OrderType type;
+        Price priceTicks;
+        Qty qty;
+        Owner ownerID;
         OrderStatus status;
+        Side side;
+        OrderType type;
+        ID orderID;
+        Time timestamp;
 
     public:
-        Order(
-            OrderID orderID_, 
-            OwnerID ownerID_, 
-            PriceTicks priceTicks_, 
-            Quantity qty_, 
+        BasicOrder(
+            ID orderID_, 
+            Owner ownerID_, 
+            Price priceTicks_, 
+            Qty qty_, 
             Side side_, 
             OrderType type_, 
-            Timestamp timestamp_
+            Time timestamp_
         )
-        :   orderID(orderID_), 
-            ownerID(ownerID_), 
-            priceTicks(priceTicks_),
+        :   priceTicks(priceTicks_),
             qty(qty_), 
+            ownerID(ownerID_), 
+            status(OrderStatus::Pending),
             side(side_),
             type(type_), 
-            timestamp(timestamp_), 
-            status(OrderStatus::Pending) {}
+            orderID(orderID_), 
+            timestamp(timestamp_) {}
 
-        inline OrderID getOrderID() const { return orderID; }
-        inline OwnerID getOwnerID() const { return ownerID; }
-        inline PriceTicks getPriceTicks() const { return priceTicks; }
-        inline Quantity getQty() const { return qty; }
+        inline ID getOrderID() const { return orderID; }
+        inline Owner getOwnerID() const { return ownerID; }
+        inline Price getPriceTicks() const { return priceTicks; }
+        inline Qty getQty() const { return qty; }
         inline Side getSide() const { return side; }
         inline OrderType getType() const { return type; }
-        inline Timestamp getTimestamp() const { return timestamp; }
+        inline Time getTimestamp() const { return timestamp; }
         inline OrderStatus getStatus() const { return status; }
 
-        inline void reduceQty(Quantity qtyFilled) { qty -= qtyFilled; }
+        inline void reduceQty(Quantity qtyFilled) { qty = static_cast<Qty>(qty - qtyFilled); }
         inline void setStatus(OrderStatus newStatus) { status = newStatus; }
         inline bool isCancelled() const { return status == OrderStatus::Cancelled || status == OrderStatus::CancelledAfterPartialExecution; }
         inline bool isExecuted() const { return status == OrderStatus::Executed; }
 };
 
-using OrderPtr = Order*;
\ No newline at end of file
+using Order = BasicOrder<DefaultOrderTraits>;
+
+static_assert(sizeof(Order) == 32, "Order must stay two per cache line");
+static_assert(alignof(Order) == 32, "Order must not straddle cache lines");
+static_assert(sizeof(BasicOrder<CompactOrderTraits>) == 24);
+
+using OrderPtr = Order*;
+
+// Opaque reference to a resting order, returned by addOrder and matchOrder. It names an
+// entry in the book's order table and the generation that entry had when the order
+// rested; the generation moves on when the order leaves the book, so a stale handle is
+// rejected rather than reaching whatever order reuses the entry.
+struct OrderHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    inline bool isNull() const { return slot == UINT32_MAX; }
+    bool operator==(const OrderHandle&) const = default;
+};
\ No newline at end of file
@@ -1,94 +1,536 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <list>
-#include <map>
 #include <unordered_map>
+#include <vector>
 #include <cstdint>
 #include <expected>
+#include <optional>
+#include <span>
+#include "models/price_levels.hpp"
+#include "policy/order_lifecycle.hpp"
 #include "policy/order_validation.hpp"
 
-using BidStructure = std::map<PriceTicks, std::list<OrderPtr>, std::greater<PriceTicks>>;
-using AskStructure = std::map<PriceTicks, std::list<OrderPtr>>;
+struct ImpactEstimate {
+    Quantity filledQty = 0;
+    int64_t notional = 0;           // sum of price * qty over the consumed liquidity, in ticks
+    PriceTicks worstPrice = 0;      // deepest price touched, 0 if nothing fills
+    uint32_t levelsConsumed = 0;
+
+    double vwap() const { return filledQty ? static_cast<double>(notional) / filledQty : 0.0; }
+};
+
+// Quantity resting ahead of an order at its price level, and the level's total.
+struct QueuePosition {
+    PriceTicks price = 0;
+    int64_t qtyAhead = 0;
+    int64_t levelQty = 0;
+};
+
+// Outcome of bulkLoad: reason is None, or why the order at index was rejected.
+struct BulkLoadResult {
+    RejectionReason reason = RejectionReason::None;
+    size_t index = 0;
+};
+
+// A price level whose quantity or order count changed.
+struct LevelChange {
+    Side side;
+    PriceTicks price;
+};
+
+// Node of a circular doubly linked list threaded through the book's order index. A
+// default-constructed or copied link is a list of its own.
+struct OwnerLink {
+    OwnerLink* prev = this;
+    OwnerLink* next = this;
+
+    OwnerLink() = default;
+    OwnerLink(const OwnerLink&) {}
+    OwnerLink& operator=(const OwnerLink&) = delete;
+
+    inline void linkBefore(OwnerLink* sentinel) {
+        prev = sentinel->prev;
+        next = sentinel;
+        prev->next = this;
+        sentinel->prev = this;
+    }
+
+    inline void unlink() {
+        prev->next = next;
+        next->prev = prev;
+        prev = next = this;
+    }
+};
+
+template <typename LevelIndex>
+class BasicLimitOrderBook {
+    public:
+        using BookOrder = typename LevelIndex::BookOrder;
+        using Handle = BookOrder*;
+        using Level = typename LevelIndex::Level;
+        using ID = typename BookOrder::ID;
+        using Owner = typename BookOrder::Owner;
+        using Bids = typename LevelIndex::Bids;
+        using Asks = typename LevelIndex::Asks;
+        using QueueIterator = typename Level::Queue::iterator;
+
+        // Where a resting order sits: its queue node and level, its slot in the level's
+        // queuedQty and its link in the owner's list of live orders on that side. Entries
+        // live in a deque and are recycled through a free list, so their addresses are
+        // stable and an OrderHandle reaches one without a lookup.
+        struct OrderEntry : OwnerLink {
+            QueueIterator position;
+            Level* level = nullptr;
+            size_t queueSlot = 0;
+            uint32_t generation = 0;
+            bool live = false;
+        };
+
+        // ID to handle. Removal by handle leaves the ID's handle behind, stale, instead of
+        // hashing the ID; stale handles are skipped on lookup and swept out in bulk.
+        using OrderIndex = std::unordered_map<ID, OrderHandle, std::hash<ID>, std::equal_to<ID>,
+            typename Level::template Allocator<std::pair<const ID, OrderHandle>>>;
+
+        // One list sentinel per side, indexed by Side. Map nodes never move, so the sentinels
+        // and the index entries linked to them keep their addresses.
+        using OwnerIndex = std::unordered_map<Owner, std::array<OwnerLink, 2>, std::hash<Owner>, std::equal_to<Owner>,
+            typename Level::template Allocator<std::pair<const Owner, std::array<OwnerLink, 2>>>>;
 
-class LimitOrderBook {
     private:
-        BidStructure bids;
-        AskStructure asks;
-        std::unordered_map<OrderID, std::list<OrderPtr>::iterator> orderIDMap;
+        Bids bids;
+        Asks asks;
+        OrderIndex orderIDMap;
+        OwnerIndex ownerOrders;
+        std::deque<OrderEntry, typename Level::template Allocator<OrderEntry>> entries;
+        std::vector<uint32_t> freeEntries;
+        size_t staleIDs = 0;
+        const InstrumentSpec* instrument = nullptr;
+        std::vector<LevelChange>* changeLog = nullptr;
+
+        inline void logChange(const Side side, PriceTicks price) {
+            if (changeLog) changeLog->push_back(LevelChange{side, price});
+        }
+
+        // Slots only grow, so a level that has seen many cancels renumbers its live orders
+        // when the tree is due to reallocate and at least half of it is dead slots.
+        void compactQueue(Level &level) {
+            level.queuedQty.assign(level.orders.begin(), level.orders.end(), [](const Handle &order) {
+                return static_cast<int64_t>(order->getQty());
+            });
+            size_t slot = 0;
+            for (const Handle& order : level.orders) {
+                entries[orderIDMap.find(order->getOrderID())->second.slot].queueSlot = slot++;
+            }
+        }
+
+        // Appends to the level's queuedQty, compacting it first when it is due to grow.
+        size_t appendQueueSlot(Level &level, Quantity qty) {
+            size_t slots = level.queuedQty.size();
+            if (slots != 0 && slots == level.queuedQty.capacity() && level.orders.size() * 2 <= slots) {
+                compactQueue(level);
+            }
+            return level.queuedQty.append(qty);
+        }
+
+        OrderEntry* resolve(const OrderHandle &handle) {
+            if (handle.slot >= entries.size()) return nullptr;
+            OrderEntry& entry = entries[handle.slot];
+            return entry.live && entry.generation == handle.generation ? &entry : nullptr;
+        }
+
+        const OrderEntry* resolve(const OrderHandle &handle) const {
+            return const_cast<BasicLimitOrderBook*>(this)->resolve(handle);
+        }
+
+        typename OrderIndex::iterator findLive(ID orderId) {
+            auto it = orderIDMap.find(orderId);
+            return it != orderIDMap.end() && resolve(it->second) ? it : orderIDMap.end();
+        }
+
+        typename OrderIndex::const_iterator findLive(ID orderId) const {
+            auto it = orderIDMap.find(orderId);
+            return it != orderIDMap.end() && resolve(it->second) ? it : orderIDMap.end();
+        }
+
+        // Appends order to the back of level's queue. Returns false if its ID is already live.
+        bool enqueue(Level &level, const Handle &order, OrderHandle* handleOut = nullptr) {
+            auto [it, inserted] = orderIDMap.try_emplace(order->getOrderID());
+            if (!inserted) {
+                if (resolve(it->second)) return false;
+                --staleIDs;
+            }
+            OrderHandle handle;
+            if (freeEntries.empty()) {
+                handle.slot = static_cast<uint32_t>(entries.size());
+                entries.emplace_back();
+            } else {
+                handle.slot = freeEntries.back();
+                freeEntries.pop_back();
+            }
+            size_t queueSlot = appendQueueSlot(level, order->getQty());
+            level.orders.push_back(order);
+            level.totalQty += order->getQty();
+            OrderEntry& entry = entries[handle.slot];
+            entry.position = std::prev(level.orders.end());
+            entry.level = &level;
+            entry.queueSlot = queueSlot;
+            entry.live = true;
+            entry.linkBefore(&ownerOrders[order->getOwnerID()][static_cast<size_t>(order->getSide())]);
+            handle.generation = entry.generation;
+            it->second = handle;
+            if (handleOut) *handleOut = handle;
+            return true;
+        }
+
+        void releaseEntry(OrderEntry &entry, uint32_t slot) {
+            entry.unlink();
+            entry.live = false;
+            ++entry.generation;
+            freeEntries.push_back(slot);
+        }
+
+        // Takes the order out of its queue, level and owner list and frees its entry; the ID
+        // index is left to the caller.
+        void detach(const OrderHandle &handle) {
+            OrderEntry& entry = entries[handle.slot];
+            Handle order = *entry.position;
+            Level& level = *entry.level;
+            PriceTicks price = order->getPriceTicks();
+            level.totalQty -= order->getQty();
+            level.queuedQty.add(entry.queueSlot, -static_cast<int64_t>(order->getQty()));
+            level.orders.erase(entry.position);
+            logChange(order->getSide(), price);
+            if (level.orders.empty()) {
+                withSide(order->getSide(), [&](auto &levels) { levels.erase(price); });
+            }
+            releaseEntry(entry, handle.slot);
+        }
+
+        void clearAll() {
+            bids.clear();
+            asks.clear();
+            orderIDMap.clear();
+            ownerOrders.clear();
+            staleIDs = 0;
+            for (uint32_t slot = 0; slot < entries.size(); ++slot) {
+                OrderEntry& entry = entries[slot];
+                if (!entry.live) continue;
+                entry.prev = entry.next = &entry;
+                entry.live = false;
+                ++entry.generation;
+                freeEntries.push_back(slot);
+            }
+        }
+
+        // Length of the run of orders from first on that side at that price, to size the level.
+        static size_t runLength(std::span<const Handle> orders, size_t first) {
+            size_t last = first + 1;
+            while (last < orders.size() && orders[last] && orders[last]->getSide() == orders[first]->getSide()
+                   && orders[last]->getPriceTicks() == orders[first]->getPriceTicks()) {
+                ++last;
+            }
+            return last - first;
+        }
+
+        template <typename Levels>
+        RejectionReason bulkAppend(Levels &levels, Level* &level, PriceTicks &levelPrice, std::span<const Handle> orders, size_t index, OrderHandle* handleOut) {
+            const Handle& order = orders[index];
+            PriceTicks price = order->getPriceTicks();
+            if (!levels.accepts(price)) {
+                return RejectionReason::PriceOutsideBand;
+            }
+            if (level && price != levelPrice) {
+                if (!Levels::isBetter(levelPrice, price)) return RejectionReason::BulkLoadOutOfOrder;
+                level = nullptr;
+            }
+            if (!level) {
+                level = &levels.emplaceWorst(price);
+                levelPrice = price;
+                level->queuedQty.reserve(level->queuedQty.size() + runLength(orders, index));
+                logChange(order->getSide(), price);
+            }
+            return enqueue(*level, order, handleOut ? &handleOut[index] : nullptr) ? RejectionReason::None : RejectionReason::AddingDuplicateOrder;
+        }
+
+        template <typename Fn>
+        decltype(auto) withSide(const Side side, Fn &&fn) {
+            if (side == Side::Buy) return fn(bids);
+            return fn(asks);
+        }
+
+        template <typename Fn>
+        decltype(auto) withSide(const Side side, Fn &&fn) const {
+            if (side == Side::Buy) return fn(bids);
+            return fn(asks);
+        }
+
+        // Copies source's resting orders into storage in entry order, which follows the order
+        // they were added in more closely than queue order does, each keeping its entry's slot,
+        // and buckets the slots by (level, queueSlot): a level's live entries hold strictly
+        // ascending queue slots in queue order. Until its level is rebuilt an entry's queueSlot
+        // holds its order's index in storage. Returns where each level's buckets start.
+        std::unordered_map<const Level*, size_t> copyOrders(const BasicLimitOrderBook &source, std::vector<BookOrder> &storage, std::vector<uint32_t> &buckets) {
+            std::unordered_map<const Level*, size_t> offsets;
+            size_t total = 0;
+            auto assign = [&](PriceTicks, const Level &level) {
+                offsets.emplace(&level, total);
+                total += level.queuedQty.size();
+                return true;
+            };
+            source.bids.forEachLevel(assign);
+            source.asks.forEachLevel(assign);
+            buckets.assign(total, UINT32_MAX);
+            entries.resize(source.entries.size());
+            for (uint32_t slot = 0; slot < source.entries.size(); ++slot) {
+                const OrderEntry& from = source.entries[slot];
+                OrderEntry& entry = entries[slot];
+                entry.generation = from.generation;
+                if (!from.live) continue;
+                buckets[offsets.find(from.level)->second + from.queueSlot] = slot;
+                entry.queueSlot = storage.size();
+                const BookOrder& order = storage.emplace_back(**from.position);
+                entry.live = true;
+                entry.linkBefore(&ownerOrders[order.getOwnerID()][static_cast<size_t>(order.getSide())]);
+            }
+            return offsets;
+        }
+
+        // Appends the levels best to worst with their queue indexes as they are and queues the
+        // copied orders bucketed under each.
+        template <typename Levels>
+        void cloneLevels(const Levels &from, Levels &to, std::vector<BookOrder> &storage,
+                         const std::unordered_map<const Level*, size_t> &offsets, const std::vector<uint32_t> &buckets) {
+            from.forEachLevel([&](PriceTicks price, const Level &level) {
+                Level& copy = to.emplaceWorst(price);
+                copy.totalQty = level.totalQty;
+                copy.queuedQty = level.queuedQty;
+                const uint32_t* bucket = buckets.data() + offsets.find(&level)->second;
+                for (size_t queueSlot = 0; queueSlot < level.queuedQty.size(); ++queueSlot) {
+                    if (bucket[queueSlot] == UINT32_MAX) continue;
+                    OrderEntry& entry = entries[bucket[queueSlot]];
+                    copy.orders.push_back(&storage[entry.queueSlot]);
+                    entry.position = std::prev(copy.orders.end());
+                    entry.level = &copy;
+                    entry.queueSlot = queueSlot;
+                }
+                return true;
+            });
+        }
 
     public:
-        LimitOrderBook() = default;
+        BasicLimitOrderBook() : BasicLimitOrderBook(nullptr) {}
+        explicit BasicLimitOrderBook(const InstrumentSpec* instrument_)
+            : bids(instrument_), asks(instrument_), instrument(instrument_) {}
+
+        // Order entries point into this book's levels and queues, so a copy would alias the
+        // source; moves are suppressed with it. Use the cloning constructor below instead.
+        BasicLimitOrderBook(const BasicLimitOrderBook&) = delete;
+        BasicLimitOrderBook& operator=(const BasicLimitOrderBook&) = delete;
+
+        // Forks source: its resting orders are copied into storage, which must be empty and
+        // must not reallocate while this book lives, and the book is rebuilt around the copies
+        // with no validation or per-order ID lookups. Level queue indexes and the ID index are
+        // copied wholesale and entries keep their slots and generations, so handles taken on
+        // source resolve to the same orders here. Owner lists follow entry order rather than
+        // the source's. The change log is not carried over.
+        BasicLimitOrderBook(const BasicLimitOrderBook &source, std::vector<BookOrder> &storage)
+            : BasicLimitOrderBook(source.instrument) {
+            storage.reserve(source.getOrderCount());
+            orderIDMap = source.orderIDMap;
+            freeEntries = source.freeEntries;
+            staleIDs = source.staleIDs;
+            std::vector<uint32_t> buckets;
+            auto offsets = copyOrders(source, storage, buckets);
+            cloneLevels(source.bids, bids, storage, offsets, buckets);
+            cloneLevels(source.asks, asks, storage, offsets, buckets);
+        }
+
+        inline const InstrumentSpec* getInstrumentSpec() const { return instrument; }
+        inline const Bids& getBids() const { return bids; }
+        inline const Asks& getAsks() const { return asks; }
+
+        // Every later level mutation appends to log until reset with nullptr; the owner drains it.
+        inline void setChangeLog(std::vector<LevelChange>* log) { changeLog = log; }
+
+        const Level* getLevel(const Side side, PriceTicks price) const {
+            return withSide(side, [&](const auto &levels) { return levels.find(price); });
+        }
 
-        bool doesOrderExist(OrderID orderId) const {
-            return orderIDMap.contains(orderId);
+        bool doesOrderExist(ID orderId) const {
+            return findLive(orderId) != orderIDMap.end();
         }
 
+        inline bool isLive(const OrderHandle &handle) const { return resolve(handle) != nullptr; }
+
         std::optional<PriceTicks> getBestBid() const {
             if (bids.empty()) return std::nullopt;
-            return bids.begin()->first;
+            return bids.bestPrice();
         }
 
         std::optional<PriceTicks> getBestAsk() const {
             if (asks.empty()) return std::nullopt;
-            return asks.begin()->first;
+            return asks.bestPrice();
         }
 
-        RejectionReason addOrder(const OrderPtr &order) {
-            RejectionReason validationResult = OrderValidator::validateBeforeAdding(order);
+        // Sets *handle to the resting order's handle when given and the order is added.
+        RejectionReason addOrder(const Handle &order, OrderHandle* handle = nullptr) {
+            RejectionReason validationResult = OrderValidator::validateBeforeAdding(order, instrument);
             if (validationResult != RejectionReason::None) {
                 return validationResult;
             }
-            OrderID orderID = order->getOrderID();
+            ID orderID = order->getOrderID();
             if (doesOrderExist(orderID)) {
                 return RejectionReason::AddingDuplicateOrder;
             }
             PriceTicks price = order->getPriceTicks();
-            if (order->getSide() == Side::Buy) {
-                bids[price].push_back(order);
-                auto it = std::prev(bids[price].end());
-                orderIDMap.emplace(orderID, it);
-            } else {
-                asks[price].push_back(order);
-                auto it = std::prev(asks[price].end());
-                orderIDMap.emplace(orderID, it);
+            return withSide(order->getSide(), [&](auto &levels) {
+                if (!levels.accepts(price)) {
+                    return RejectionReason::PriceOutsideBand;
+                }
+                enqueue(levels.getOrCreate(price), order, handle);
+                logChange(order->getSide(), price);
+                return RejectionReason::None;
+            });
+        }
+
+        inline size_t getOrderCount() const { return orderIDMap.size() - staleIDs; }
+
+        // Builds an empty book from orders in one pass. On each side orders must come best
+        // price first and in queue order within a price; the sides may be interleaved. Each
+        // level is appended after the current worst one and its queue index sized from the
+        // run of orders at its price, and the order index is reserved up front, so no order
+        // pays for a level search or an index rehash. Orders are validated as by addOrder.
+        // On a rejection the book is left empty. handles, if given, receives one handle per order.
+        BulkLoadResult bulkLoad(std::span<const Handle> orders, OrderHandle* handles = nullptr) {
+            if (getOrderCount() != 0) {
+                return BulkLoadResult{RejectionReason::BulkLoadIntoNonEmptyBook, 0};
             }
-            return RejectionReason::None;
+            orderIDMap.reserve(orders.size());
+            Level* bidLevel = nullptr;
+            Level* askLevel = nullptr;
+            PriceTicks bidPrice = 0;
+            PriceTicks askPrice = 0;
+            for (size_t i = 0; i < orders.size(); ++i) {
+                RejectionReason result = OrderValidator::validateBeforeAdding(orders[i], instrument);
+                if (result == RejectionReason::None) {
+                    result = orders[i]->getSide() == Side::Buy
+                        ? bulkAppend(bids, bidLevel, bidPrice, orders, i, handles)
+                        : bulkAppend(asks, askLevel, askPrice, orders, i, handles);
+                }
+                if (result != RejectionReason::None) {
+                    clearAll();
+                    return BulkLoadResult{result, i};
+                }
+            }
+            return BulkLoadResult{};
         }
 
-        RejectionReason removeOrder(OrderID orderId) {
-            auto it = orderIDMap.find(orderId);
+        RejectionReason removeOrder(ID orderId) {
+            auto it = findLive(orderId);
             if (it == orderIDMap.end())
                 return RejectionReason::OrderToBeRemovedDoesNotExist;
-            OrderPtr order = *(it->second);
+            Handle order = *entries[it->second.slot].position;
             RejectionReason validationResult = OrderValidator::validateBeforeRemoving(order);
             if (validationResult != RejectionReason::None) {
                 return validationResult;
             }
-            if (order->getSide() == Side::Buy) {
-                auto bookIt = bids.find(order->getPriceTicks());
-                if (bookIt != bids.end()) {
-                    bookIt->second.erase(it->second);
-                    if (bookIt->second.empty())
-                        bids.erase(bookIt);
-                }
-                else {
-                    return RejectionReason::OrderBookInvariantViolation;
-                }
+            eraseEntry(it);
+            return RejectionReason::None;
+        }
+
+        // Takes a resting order out of the book whatever its status; the engine uses this once it
+        // has already set the final status of an order it filled or cancelled away from the queue head.
+        RejectionReason evictOrder(ID orderId) {
+            auto it = findLive(orderId);
+            if (it == orderIDMap.end())
+                return RejectionReason::OrderToBeRemovedDoesNotExist;
+            eraseEntry(it);
+            return RejectionReason::None;
+        }
+
+        // Removes the order without hashing its ID or searching for its level; a stale handle
+        // is rejected as OrderToBeRemovedDoesNotExist.
+        RejectionReason removeOrder(const OrderHandle &handle) {
+            OrderEntry* entry = resolve(handle);
+            if (!entry)
+                return RejectionReason::OrderToBeRemovedDoesNotExist;
+            RejectionReason validationResult = OrderValidator::validateBeforeRemoving(*entry->position);
+            if (validationResult != RejectionReason::None) {
+                return validationResult;
+            }
+            detach(handle);
+            ++staleIDs;
+            if (staleIDs >= 1024 && staleIDs > getOrderCount()) {
+                std::erase_if(orderIDMap, [&](const auto &item) { return !resolve(item.second); });
+                staleIDs = 0;
+            }
+            return RejectionReason::None;
+        }
+
+        // Sets a resting order's quantity. A decrease keeps its queue position; an increase
+        // moves it to the back of its level, as a cancel-replace would. Price changes are a
+        // removeOrder and addOrder.
+        RejectionReason modifyQty(const OrderHandle &handle, Quantity newQty) {
+            OrderEntry* entry = resolve(handle);
+            if (!entry)
+                return RejectionReason::OrderToBeRemovedDoesNotExist;
+            if (newQty <= 0)
+                return RejectionReason::InvalidQuantity;
+            Handle order = *entry->position;
+            Level& level = *entry->level;
+            Quantity oldQty = order->getQty();
+            level.totalQty += newQty - oldQty;
+            order->reduceQty(oldQty - newQty);
+            if (newQty > oldQty) {
+                // Held outside the queue while its new slot is appended, so a compaction
+                // there does not count it as well.
+                level.queuedQty.add(entry->queueSlot, -static_cast<int64_t>(oldQty));
+                typename Level::Queue moving;
+                moving.splice(moving.end(), level.orders, entry->position);
+                entry->queueSlot = appendQueueSlot(level, newQty);
+                level.orders.splice(level.orders.end(), moving);
             } else {
-                auto bookIt = asks.find(order->getPriceTicks());
-                if (bookIt != asks.end()) {
-                    bookIt->second.erase(it->second);
-                    if (bookIt->second.empty())
-                        asks.erase(bookIt);
-                }
-                else {
-                    return RejectionReason::OrderBookInvariantViolation;
-                }
+                level.queuedQty.add(entry->queueSlot, newQty - oldQty);
             }
-            orderIDMap.erase(it);
+            logChange(order->getSide(), order->getPriceTicks());
             return RejectionReason::None;
         }
 
-        bool isOrderMarketable(const OrderPtr &order) const {
+        // Cancels every resting order of owner, on one side or both, in O(k) for k orders
+        // removed: each order is linked into its owner's per-side list when it rests. Sets
+        // each order's cancelled status and appends it to cancelled if given. Returns k.
+        size_t cancelAllForOwner(Owner owner, std::optional<Side> side = std::nullopt, std::vector<Handle>* cancelled = nullptr) {
+            auto owned = ownerOrders.find(owner);
+            if (owned == ownerOrders.end()) return 0;
+            size_t count = 0;
+            for (Side listSide : {Side::Buy, Side::Sell}) {
+                if (side && *side != listSide) continue;
+                OwnerLink& sentinel = owned->second[static_cast<size_t>(listSide)];
+                while (sentinel.next != &sentinel) {
+                    Handle order = *static_cast<OrderEntry*>(sentinel.next)->position;
+                    eraseEntry(orderIDMap.find(order->getOrderID()));
+                    order->setStatus(OrderLifecycle::afterCancelResting(order->getStatus()));
+                    if (cancelled) cancelled->push_back(order);
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // Live orders of owner on side, walking its list.
+        size_t countOwnerOrders(Owner owner, const Side side) const {
+            auto owned = ownerOrders.find(owner);
+            if (owned == ownerOrders.end()) return 0;
+            const OwnerLink& sentinel = owned->second[static_cast<size_t>(side)];
+            size_t count = 0;
+            for (const OwnerLink* link = sentinel.next; link != &sentinel; link = link->next) ++count;
+            return count;
+        }
+
+        bool isOrderMarketable(const Handle &order) const {
             if (order->getQty() == 0) return false;
             Side side = order->getSide();
             if (side == Side::Buy && asks.empty()) return false;
@@ -103,37 +545,123 @@ class LimitOrderBook {
             }
         }
 
-        OrderPtr getMatchedOrder(const Side incomingSide) const {
-            if (incomingSide == Side::Buy) {
-                if (asks.empty() || asks.begin()->second.empty()) return nullptr;
-                return asks.begin()->second.front();
-            } else {
-                if (bids.empty() || bids.begin()->second.empty()) return nullptr;
-                return bids.begin()->second.front();
-            }
+        Handle getMatchedOrder(const Side incomingSide) const {
+            return withSide(opposite(incomingSide), [](const auto &levels) -> Handle {
+                if (levels.empty() || levels.best().orders.empty()) return nullptr;
+                return levels.best().orders.front();
+            });
         }
 
         void popFront(const Side incomingSide) {
-            if (incomingSide == Side::Buy) {
-                if (!asks.empty()) {
-                    auto& askList = asks.begin()->second;
-                    auto bestAskOrder = askList.front();
-                    orderIDMap.erase(bestAskOrder->getOrderID());
-                    askList.pop_front();
-                    if (askList.empty()) {
-                        asks.erase(asks.begin());
-                    }
+            withSide(opposite(incomingSide), [&](auto &levels) {
+                if (levels.empty()) return;
+                logChange(opposite(incomingSide), levels.bestPrice());
+                Level& level = levels.best();
+                Handle bestOrder = level.orders.front();
+                level.totalQty -= bestOrder->getQty();
+                auto it = orderIDMap.find(bestOrder->getOrderID());
+                OrderEntry& entry = entries[it->second.slot];
+                level.queuedQty.add(entry.queueSlot, -static_cast<int64_t>(bestOrder->getQty()));
+                releaseEntry(entry, it->second.slot);
+                orderIDMap.erase(it);
+                level.orders.pop_front();
+                if (level.orders.empty()) {
+                    levels.eraseBest();
                 }
-            } else {
-                if (!bids.empty()) {
-                    auto& bidList = bids.begin()->second;
-                    auto bestBidOrder = bidList.front();
-                    orderIDMap.erase(bestBidOrder->getOrderID());
-                    bidList.pop_front();
-                    if (bidList.empty()) {
-                        bids.erase(bids.begin());
-                    }
-                }
-            }
+            });
+        }
+
+        const Level* getBestLevel(const Side incomingSide) const {
+            return withSide(opposite(incomingSide), [](const auto &levels) -> const Level* {
+                return levels.empty() ? nullptr : &levels.best();
+            });
+        }
+
+        // Keeps the level aggregate in step when the order at the head of the best level is filled in place.
+        void reduceBestLevelQty(const Side incomingSide, Quantity filledQty) {
+            withSide(opposite(incomingSide), [&](auto &levels) {
+                if (levels.empty()) return;
+                Level& level = levels.best();
+                level.totalQty -= filledQty;
+                level.queuedQty.add(entries[orderIDMap.find(level.orders.front()->getOrderID())->second.slot].queueSlot, -filledQty);
+                logChange(opposite(incomingSide), levels.bestPrice());
+            });
         }
-};
\ No newline at end of file
+
+        // Same for a resting order anywhere in its queue, after its qty was already reduced by filledQty.
+        RejectionReason reduceRestingQty(const Handle &order, Quantity filledQty) {
+            auto it = findLive(order->getOrderID());
+            if (it == orderIDMap.end())
+                return RejectionReason::OrderToBeRemovedDoesNotExist;
+            OrderEntry& entry = entries[it->second.slot];
+            entry.level->totalQty -= filledQty;
+            entry.level->queuedQty.add(entry.queueSlot, -filledQty);
+            logChange(order->getSide(), order->getPriceTicks());
+            return RejectionReason::None;
+        }
+
+        // Quantity of the orders queued ahead of orderId at its level; O(log n) in the
+        // number of orders that have joined the level since it was created or compacted.
+        std::optional<QueuePosition> getQueuePosition(ID orderId) const {
+            auto it = findLive(orderId);
+            if (it == orderIDMap.end()) return std::nullopt;
+            return getQueuePosition(it->second);
+        }
+
+        std::optional<QueuePosition> getQueuePosition(const OrderHandle &handle) const {
+            const OrderEntry* entry = resolve(handle);
+            if (!entry) return std::nullopt;
+            return QueuePosition{(*entry->position)->getPriceTicks(), entry->level->queuedQty.prefix(entry->queueSlot), entry->level->totalQty};
+        }
+
+        // Walks the opposite side's level aggregates as an incoming order of incomingSide
+        // would consume them. Read-only, and costs one step per level rather than per order.
+        ImpactEstimate estimateImpact(const Side incomingSide, Quantity qty) const {
+            return withSide(opposite(incomingSide), [&](const auto &levels) {
+                return walkLevels(levels, qty, INT64_MAX);
+            });
+        }
+
+        // Same walk, bounded by notional (price * qty in ticks) instead of quantity.
+        ImpactEstimate estimateImpactForNotional(const Side incomingSide, int64_t notional) const {
+            return withSide(opposite(incomingSide), [&](const auto &levels) {
+                return walkLevels(levels, INT32_MAX, notional);
+            });
+        }
+
+    private:
+        void eraseEntry(typename OrderIndex::iterator it) {
+            detach(it->second);
+            orderIDMap.erase(it);
+        }
+
+        static constexpr Side opposite(const Side side) {
+            return side == Side::Buy ? Side::Sell : Side::Buy;
+        }
+
+        template <typename Levels>
+        static ImpactEstimate walkLevels(const Levels &levels, Quantity qty, int64_t notional) {
+            ImpactEstimate estimate;
+            levels.forEachLevel([&](PriceTicks price, const Level &level) {
+                int64_t take = std::min<int64_t>(level.totalQty, qty);
+                take = std::min<int64_t>(take, notional / price);
+                if (take <= 0) return false;
+                estimate.filledQty += static_cast<Quantity>(take);
+                estimate.notional += take * price;
+                estimate.worstPrice = price;
+                estimate.levelsConsumed++;
+                qty -= static_cast<Quantity>(take);
+                notional -= take * price;
+                return qty > 0;
+            });
+            return estimate;
+        }
+};
+
+using LimitOrderBook = BasicLimitOrderBook<MapLevelIndex>;
+using LadderOrderBook = BasicLimitOrderBook<LadderLevelIndex>;
+
+template <typename Traits>
+using LimitOrderBookFor = BasicLimitOrderBook<BasicMapLevelIndex<BasicOrder<Traits>>>;
+template <typename Traits>
+using LadderOrderBookFor = BasicLimitOrderBook<BasicLadderLevelIndex<BasicOrder<Traits>>>;
@@ -0,0 +1,196 @@
+#pragma once
+#include <functional>
+#include <list>
+#include <map>
+#include <vector>
+#include "models/instrument.hpp"
+#include "utils/fenwick_tree.hpp"
+#include "utils/occupancy_bitmap.hpp"
+
+template <typename OrderT>
+struct BasicPriceLevel {
+    template <typename U>
+    using Allocator = typename TraitsAllocator<typename OrderT::Traits, U>::type;
+    using Queue = std::list<OrderT*, Allocator<OrderT*>>;
+
+    Queue orders;
+    int64_t totalQty = 0;
+    FenwickTree<Allocator<int64_t>> queuedQty;     // resting qty by arrival slot, for queue positions
+
+    inline void reset() {
+        totalQty = 0;
+        queuedQty.clear();
+    }
+};
+
+using PriceLevel = BasicPriceLevel<Order>;
+
+// One side of the book keyed by price, best level first. Both containers expose the
+// same surface so LimitOrderBook can be instantiated over either.
+template <typename Compare, typename Level = PriceLevel>
+class MapLevels {
+    private:
+        std::map<PriceTicks, Level, Compare, typename Level::template Allocator<std::pair<const PriceTicks, Level>>> levels;
+
+    public:
+        explicit MapLevels(const InstrumentSpec*) {}
+
+        static bool isBetter(PriceTicks a, PriceTicks b) { return Compare{}(a, b); }
+
+        inline bool accepts(PriceTicks) const { return true; }
+        inline bool empty() const { return levels.empty(); }
+        inline size_t levelCount() const { return levels.size(); }
+        inline PriceTicks bestPrice() const { return levels.begin()->first; }
+        inline Level& best() { return levels.begin()->second; }
+        inline const Level& best() const { return levels.begin()->second; }
+
+        Level* find(PriceTicks price) {
+            auto it = levels.find(price);
+            return it == levels.end() ? nullptr : &it->second;
+        }
+
+        const Level* find(PriceTicks price) const {
+            auto it = levels.find(price);
+            return it == levels.end() ? nullptr : &it->second;
+        }
+
+        inline Level& getOrCreate(PriceTicks price) { return levels[price]; }
+
+        // Appends a level worse than every existing one; used by one-pass rebuilds.
+        inline Level& emplaceWorst(PriceTicks price) {
+            return levels.emplace_hint(levels.end(), price, Level{})->second;
+        }
+
+        inline void erase(PriceTicks price) { levels.erase(price); }
+        inline void eraseBest() { levels.erase(levels.begin()); }
+        inline void clear() { levels.clear(); }
+
+        // Visits levels best to worst until fn returns false.
+        template <typename Fn>
+        void forEachLevel(Fn &&fn) const {
+            for (const auto& [price, level] : levels) {
+                if (!fn(price, level)) return;
+            }
+        }
+};
+
+// Array ladder over the instrument's price band with an occupancy bitmap as the level
+// index. Finding the next populated price after the best level empties is a bitmap
+// search instead of a tree walk. Prices outside the band are not accepted.
+template <Side S, typename Level = PriceLevel>
+class LadderLevels {
+    private:
+        PriceTicks lowPrice = 0;
+        std::vector<Level, typename Level::template Allocator<Level>> ladder;
+        OccupancyBitmap occupied;
+        size_t bestSlot = OccupancyBitmap::npos;
+        size_t count = 0;
+
+        inline size_t slotOf(PriceTicks price) const { return static_cast<size_t>(price - lowPrice); }
+        inline PriceTicks priceOf(size_t slot) const { return lowPrice + static_cast<PriceTicks>(slot); }
+
+        inline size_t nextWorse(size_t slot) const {
+            if constexpr (S == Side::Buy) {
+                return slot == 0 ? OccupancyBitmap::npos : occupied.findPrev(slot - 1);
+            } else {
+                return occupied.findNext(slot + 1);
+            }
+        }
+
+        inline void occupy(size_t slot) {
+            occupied.set(slot);
+            ++count;
+            if (bestSlot == OccupancyBitmap::npos || isBetter(priceOf(slot), priceOf(bestSlot))) {
+                bestSlot = slot;
+            }
+        }
+
+    public:
+        explicit LadderLevels(const InstrumentSpec* instrument) {
+            if (!instrument) return;
+            const PriceBand& band = instrument->getPriceBand();
+            lowPrice = band.low;
+            ladder.resize(static_cast<size_t>(band.width()));
+            occupied = OccupancyBitmap(ladder.size());
+        }
+
+        static bool isBetter(PriceTicks a, PriceTicks b) {
+            if constexpr (S == Side::Buy) return a > b;
+            else return a < b;
+        }
+
+        inline bool accepts(PriceTicks price) const { return price >= lowPrice && slotOf(price) < ladder.size(); }
+        inline bool empty() const { return count == 0; }
+        inline size_t levelCount() const { return count; }
+        inline PriceTicks bestPrice() const { return priceOf(bestSlot); }
+        inline Level& best() { return ladder[bestSlot]; }
+        inline const Level& best() const { return ladder[bestSlot]; }
+
+        Level* find(PriceTicks price) {
+            if (!accepts(price)) return nullptr;
+            size_t slot = slotOf(price);
+            return occupied.test(slot) ? &ladder[slot] : nullptr;
+        }
+
+        const Level* find(PriceTicks price) const {
+            if (!accepts(price)) return nullptr;
+            size_t slot = slotOf(price);
+            return occupied.test(slot) ? &ladder[slot] : nullptr;
+        }
+
+        Level& getOrCreate(PriceTicks price) {
+            size_t slot = slotOf(price);
+            if (!occupied.test(slot)) occupy(slot);
+            return ladder[slot];
+        }
+
+        inline Level& emplaceWorst(PriceTicks price) { return getOrCreate(price); }
+
+        void erase(PriceTicks price) {
+            size_t slot = slotOf(price);
+            ladder[slot].reset();
+            occupied.clear(slot);
+            --count;
+            if (slot == bestSlot) {
+                bestSlot = nextWorse(slot);
+            }
+        }
+
+        inline void eraseBest() { erase(bestPrice()); }
+
+        void clear() {
+            for (size_t slot = bestSlot; slot != OccupancyBitmap::npos; slot = nextWorse(slot)) {
+                ladder[slot] = Level{};
+                occupied.clear(slot);
+            }
+            bestSlot = OccupancyBitmap::npos;
+            count = 0;
+        }
+
+        template <typename Fn>
+        void forEachLevel(Fn &&fn) const {
+            for (size_t slot = bestSlot; slot != OccupancyBitmap::npos; slot = nextWorse(slot)) {
+                if (!fn(priceOf(slot), ladder[slot])) return;
+            }
+        }
+};
+
+// A level index fixes both the level container and the order type the book holds.
+template <typename OrderT>
+struct BasicMapLevelIndex {
+    using BookOrder = OrderT;
+    using Level = BasicPriceLevel<OrderT>;
+    using Bids = MapLevels<std::greater<PriceTicks>, Level>;
+    using Asks = MapLevels<std::less<PriceTicks>, Level>;
+};
+
+template <typename OrderT>
+struct BasicLadderLevelIndex {
+    using BookOrder = OrderT;
+    using Level = BasicPriceLevel<OrderT>;
+    using Bids = LadderLevels<Side::Buy, Level>;
+    using Asks = LadderLevels<Side::Sell, Level>;
+};
+
+using MapLevelIndex = BasicMapLevelIndex<Order>;
+using LadderLevelIndex = BasicLadderLevelIndex<Order>;
@@ -0,0 +1,37 @@
+#pragma once
+#include "models/price_levels.hpp"
+#include "utils/seqlock.hpp"
+
+// Best bid/ask with the aggregate quantity and order count resting there. A missing side
+// has price 0 and quantity 0. sequence is the publisher's event counter.
+struct TopOfBook {
+    PriceTicks bidPrice = 0;
+    PriceTicks askPrice = 0;
+    int64_t bidQty = 0;
+    int64_t askQty = 0;
+    uint32_t bidOrders = 0;
+    uint32_t askOrders = 0;
+    uint64_t sequence = 0;
+
+    inline bool hasBid() const { return bidQty > 0; }
+    inline bool hasAsk() const { return askQty > 0; }
+
+    template <typename Book>
+    static TopOfBook capture(const Book &book, uint64_t sequence) {
+        TopOfBook top;
+        top.sequence = sequence;
+        if (const auto* bid = book.getBestLevel(Side::Sell)) {
+            top.bidPrice = *book.getBestBid();
+            top.bidQty = bid->totalQty;
+            top.bidOrders = static_cast<uint32_t>(bid->orders.size());
+        }
+        if (const auto* ask = book.getBestLevel(Side::Buy)) {
+            top.askPrice = *book.getBestAsk();
+            top.askQty = ask->totalQty;
+            top.askOrders = static_cast<uint32_t>(ask->orders.size());
+        }
+        return top;
+    }
+};
+
+using TopOfBookFeed = Seqlock<TopOfBook>;
@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "models/price_levels.hpp"
+
+// Splits an incoming quantity across the resting orders of one price level. allocations
+// has one slot per order in FIFO order; implementations write every slot, never give an
+// order more than its qty, and allocate min(incomingQty, level.totalQty) in total.
+template <typename OrderT>
+class BasicAllocationPolicy {
+    public:
+        using Level = BasicPriceLevel<OrderT>;
+
+        virtual ~BasicAllocationPolicy() = default;
+
+        virtual void allocate(const Level &level, Quantity incomingQty, std::span<Quantity> allocations) const = 0;
+
+    protected:
+        // Hands out what is left of remaining in time priority on top of existing allocations.
+        static Quantity allocateFifo(const Level &level, Quantity remaining, std::span<Quantity> allocations) {
+            size_t i = 0;
+            for (auto it = level.orders.begin(); it != level.orders.end() && remaining > 0; ++it, ++i) {
+                Quantity extra = std::min<Quantity>((*it)->getQty() - allocations[i], remaining);
+                allocations[i] += extra;
+                remaining -= extra;
+            }
+            return remaining;
+        }
+
+        static Quantity levelTarget(const Level &level, Quantity incomingQty) {
+            return static_cast<Quantity>(std::min<int64_t>(incomingQty, level.totalQty));
+        }
+};
+
+template <typename OrderT>
+class BasicFifoAllocation final : public BasicAllocationPolicy<OrderT> {
+    using Base = BasicAllocationPolicy<OrderT>;
+    using typename Base::Level;
+
+    public:
+        void allocate(const Level &level, Quantity incomingQty, std::span<Quantity> allocations) const override {
+            std::fill(allocations.begin(), allocations.end(), 0);
+            Base::allocateFifo(level, Base::levelTarget(level, incomingQty), allocations);
+        }
+};
+
+// Each order gets floor(qty * target / levelQty); shares under minAllocation are dropped
+// and everything left over, rounding included, goes out FIFO.
+template <typename OrderT>
+class BasicProRataAllocation final : public BasicAllocationPolicy<OrderT> {
+    using Base = BasicAllocationPolicy<OrderT>;
+    using typename Base::Level;
+
+    private:
+        Quantity minAllocation;
+
+    public:
+        explicit BasicProRataAllocation(Quantity minAllocation_ = 1) : minAllocation(minAllocation_) {}
+
+        void allocate(const Level &level, Quantity incomingQty, std::span<Quantity> allocations) const override {
+            Quantity target = Base::levelTarget(level, incomingQty);
+            Quantity remaining = target;
+            size_t i = 0;
+            for (const OrderT* order : level.orders) {
+                Quantity share = static_cast<Quantity>(static_cast<int64_t>(order->getQty()) * target / level.totalQty);
+                if (share < minAllocation) share = 0;
+                allocations[i++] = share;
+                remaining -= share;
+            }
+            Base::allocateFifo(level, remaining, allocations);
+        }
+};
+
+// Lead market makers first share up to lmmPercent of the level target among themselves in
+// time priority; the rest of the target then goes FIFO across every order at the level.
+template <typename OrderT>
+class BasicLmmFifoAllocation final : public BasicAllocationPolicy<OrderT> {
+    using Base = BasicAllocationPolicy<OrderT>;
+    using typename Base::Level;
+    using Owner = typename OrderT::Owner;
+
+    private:
+        std::vector<Owner> leadMarketMakers;
+        uint32_t lmmPercent;
+
+        bool isLeadMarketMaker(Owner owner) const {
+            return std::find(leadMarketMakers.begin(), leadMarketMakers.end(), owner) != leadMarketMakers.end();
+        }
+
+    public:
+        BasicLmmFifoAllocation(std::vector<Owner> leadMarketMakers_, uint32_t lmmPercent_)
+            : leadMarketMakers(std::move(leadMarketMakers_)), lmmPercent(std::min<uint32_t>(lmmPercent_, 100)) {}
+
+        void allocate(const Level &level, Quantity incomingQty, std::span<Quantity> allocations) const override {
+            Quantity target = Base::levelTarget(level, incomingQty);
+            Quantity lmmRemaining = static_cast<Quantity>(static_cast<int64_t>(target) * lmmPercent / 100);
+            Quantity remaining = target - lmmRemaining;
+            size_t i = 0;
+            for (const OrderT* order : level.orders) {
+                Quantity share = 0;
+                if (lmmRemaining > 0 && isLeadMarketMaker(order->getOwnerID())) {
+                    share = std::min<Quantity>(order->getQty(), lmmRemaining);
+                    lmmRemaining -= share;
+                }
+                allocations[i++] = share;
+            }
+            Base::allocateFifo(level, remaining + lmmRemaining, allocations);
+        }
+};
+
+using AllocationPolicy = BasicAllocationPolicy<Order>;
+using FifoAllocation = BasicFifoAllocation<Order>;
+using ProRataAllocation = BasicProRataAllocation<Order>;
+using LmmFifoAllocation = BasicLmmFifoAllocation<Order>;
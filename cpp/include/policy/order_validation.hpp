@@ -1,5 +1,6 @@
 #pragma once
 #include "models/order.hpp"
+#include "models/instrument.hpp"
 
 enum class RejectionReason : uint8_t {
     None,                               // No rejection, order is valid
@@ -13,12 +14,33 @@ enum class RejectionReason : uint8_t {
     OrderToBeRemovedDoesNotExist,       // trying to cancel an order that doesn't exist
     OrderToBeRemovedAlreadyCancelled,   // trying to cancel an order that is already cancelled
     OrderToBeRemovedAlreadyExecuted,    // trying to cancel an order that is already executed
-    OrderBookInvariantViolation         // order book invariant violation
+    OrderBookInvariantViolation,        // order book invariant violation
+    PriceOutsideBand,                   // limit price outside the instrument's price collar
+    PriceNotOnTick,                     // limit price not on the instrument's tick ladder
+    BulkLoadIntoNonEmptyBook,           // bulkLoad called on a book that already holds orders
+    BulkLoadOutOfOrder                  // bulkLoad input not best price first and FIFO within a price
 };
 
 class OrderValidator {
     public:
-        static RejectionReason validateBeforeAdding(const OrderPtr &order) {
+        // Band check first: it is two compares and rejects far-away prices before the ladder lookup.
+        template <typename OrderT>
+        static RejectionReason validatePrice(const OrderT* order, const InstrumentSpec* instrument) {
+            if (!instrument || order->getType() == OrderType::Market) {
+                return RejectionReason::None;
+            }
+            PriceTicks price = order->getPriceTicks();
+            if (!instrument->getPriceBand().contains(price)) {
+                return RejectionReason::PriceOutsideBand;
+            }
+            if (!instrument->getTickLadder().isValidPrice(price)) {
+                return RejectionReason::PriceNotOnTick;
+            }
+            return RejectionReason::None;
+        }
+
+        template <typename OrderT>
+        static RejectionReason validateBeforeAdding(const OrderT* order, const InstrumentSpec* instrument = nullptr) {
             if (!order) {
                 return RejectionReason::NullOrder;
             }
@@ -35,6 +57,11 @@ class OrderValidator {
                 return RejectionReason::InvalidPrice;
             }
 
+            RejectionReason priceResult = validatePrice(order, instrument);
+            if (priceResult != RejectionReason::None) {
+                return priceResult;
+            }
+
             if (order->isCancelled()) {
                 return RejectionReason::AddingCancelledOrder;
             }
@@ -46,7 +73,8 @@ class OrderValidator {
             return RejectionReason::None;
         }
 
-        static RejectionReason validateBeforeRemoving(const OrderPtr &order) {
+        template <typename OrderT>
+        static RejectionReason validateBeforeRemoving(const OrderT* order) {
             if (!order || order->isCancelled() || order->isExecuted()) {
                 return RejectionReason::OrderBookInvariantViolation;
             }
@@ -0,0 +1,343 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "models/matching_engine.hpp"
+#include "policy/self_trade_prevention.hpp"
+
+enum class AgentKind : uint8_t { MarketMaker, Momentum, Noise, LiquidityTaker };
+
+struct AgentSimulationConfig {
+    uint64_t seed = 1;
+    PriceTicks initialPrice = 10000;
+    uint32_t marketMakers = 10;
+    uint32_t momentumTraders = 20;
+    uint32_t noiseTraders = 60;
+    uint32_t liquidityTakers = 10;
+    uint64_t stepsPerDay = 23400;
+};
+
+struct AgentSimulationStats {
+    uint64_t steps = 0;
+    uint64_t ordersSubmitted = 0;
+    uint64_t cancels = 0;
+    uint64_t fills = 0;
+    int64_t volume = 0;
+    PriceTicks lastTradePrice = 0;
+};
+
+// Per-owner execution ledger fed from the engine's fill reports. Cash is in price ticks.
+struct AgentLedger {
+    std::vector<int64_t> position;
+    std::vector<int64_t> cash;
+    std::vector<int64_t> tradedQty;
+
+    void resize(size_t owners) {
+        position.resize(owners, 0);
+        cash.resize(owners, 0);
+        tradedQty.resize(owners, 0);
+    }
+
+    void apply(OwnerID owner, Side side, PriceTicks price, Quantity qty) {
+        int64_t signedQty = side == Side::Buy ? qty : -qty;
+        position[owner] += signedQty;
+        cash[owner] -= signedQty * price;
+        tradedQty[owner] += qty;
+    }
+};
+
+// Agents are stored per kind as parallel arrays and stepped in fixed kind/index order, so a
+// step is a handful of tight loops with no virtual dispatch and the run is a pure function
+// of the seed. Owner IDs are dense: owner = agent index + 1 across the kinds in declaration order.
+template <typename Book = LimitOrderBook>
+class AgentSimulation {
+    private:
+        static constexpr size_t NOISE_ORDERS = 4;
+
+        struct AgentRef {
+            AgentKind kind;
+            uint32_t index;
+        };
+
+        struct MarketMakers {
+            std::vector<OwnerID> owner;
+            std::vector<PriceTicks> halfSpread;
+            std::vector<Quantity> quoteSize;
+            std::vector<int64_t> maxInventory;
+            std::vector<uint32_t> requoteEvery;
+            std::vector<OrderID> bidID;
+            std::vector<OrderID> askID;
+        };
+
+        struct MomentumTraders {
+            std::vector<OwnerID> owner;
+            std::vector<double> fastEma;
+            std::vector<double> slowEma;
+            std::vector<double> threshold;
+            std::vector<Quantity> clipSize;
+            std::vector<int64_t> maxPosition;
+        };
+
+        struct NoiseTraders {
+            std::vector<OwnerID> owner;
+            std::vector<uint32_t> actThreshold;
+            std::vector<PriceTicks> maxOffset;
+            std::vector<Quantity> maxQty;
+            std::vector<std::array<OrderID, NOISE_ORDERS>> liveIDs;
+            std::vector<uint8_t> nextSlot;
+        };
+
+        struct LiquidityTakers {
+            std::vector<OwnerID> owner;
+            std::vector<uint32_t> actThreshold;
+            std::vector<Quantity> maxQty;
+        };
+
+        // Resting orders never leave the book without a fill or an owner cancel under
+        // CancelIncomingSTP, which lets order slots be recycled from fill reports alone.
+        CancelIncomingSTP stpPolicy;
+        Book book;
+        BasicMatchingEngine<Book> engine;
+
+        // OrderID = slot + 1. A slot is reused only after its order has left the book and its
+        // owner has forgotten the ID, so IDs are unique among live orders.
+        std::deque<Order> orderSlots;
+        std::vector<uint32_t> freeSlots;
+
+        std::vector<AgentRef> agentByOwner;
+        AgentLedger ledger;
+        MarketMakers makers;
+        MomentumTraders momentum;
+        NoiseTraders noise;
+        LiquidityTakers takers;
+
+        uint64_t rngState;
+        PriceTicks initialPrice;
+        PriceTicks lastReference;
+        uint64_t stepsPerDay;
+        AgentSimulationStats stats;
+
+        uint64_t nextRandom() {
+            rngState ^= rngState << 13;
+            rngState ^= rngState >> 7;
+            rngState ^= rngState << 17;
+            return rngState;
+        }
+
+        uint64_t randomBelow(uint64_t bound) { return nextRandom() % bound; }
+        bool chance(uint32_t threshold) { return static_cast<uint32_t>(nextRandom() >> 32) < threshold; }
+        static uint32_t probability(double p) { return static_cast<uint32_t>(p * 4294967295.0); }
+
+        OwnerID registerAgent(AgentKind kind, uint32_t index) {
+            agentByOwner.push_back(AgentRef{kind, index});
+            return static_cast<OwnerID>(agentByOwner.size() - 1);
+        }
+
+        // Mid when both sides are quoted; an odd spread rounds toward the previous reference so
+        // flooring does not drag the price down over a long run.
+        PriceTicks referencePrice() {
+            auto bid = book.getBestBid();
+            auto ask = book.getBestAsk();
+            if (bid && ask) {
+                PriceTicks mid = (*bid + *ask) / 2;
+                if ((*bid + *ask) % 2 != 0 && lastReference > mid) ++mid;
+                lastReference = mid;
+            } else if (stats.lastTradePrice) {
+                lastReference = stats.lastTradePrice;
+            }
+            return lastReference;
+        }
+
+        OrderPtr allocateOrder(OwnerID owner, PriceTicks price, Quantity qty, Side side, OrderType type) {
+            uint32_t slot;
+            if (freeSlots.empty()) {
+                slot = static_cast<uint32_t>(orderSlots.size());
+                orderSlots.emplace_back(slot + 1, owner, price, qty, side, type, stats.steps);
+            } else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                orderSlots[slot] = Order(slot + 1, owner, price, qty, side, type, stats.steps);
+            }
+            return &orderSlots[slot];
+        }
+
+        inline void releaseOrder(OrderID id) { freeSlots.push_back(id - 1); }
+
+        void forgetOrder(OwnerID owner, OrderID id) {
+            AgentRef agent = agentByOwner[owner];
+            switch (agent.kind) {
+                case AgentKind::MarketMaker:
+                    if (makers.bidID[agent.index] == id) makers.bidID[agent.index] = 0;
+                    if (makers.askID[agent.index] == id) makers.askID[agent.index] = 0;
+                    break;
+                case AgentKind::Noise:
+                    for (OrderID& liveID : noise.liveIDs[agent.index]) {
+                        if (liveID == id) liveID = 0;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Returns the order's ID if it is left resting, 0 otherwise.
+        OrderID submit(OwnerID owner, PriceTicks price, Quantity qty, Side side, OrderType type) {
+            if (qty <= 0 || (type == OrderType::Limit && price <= 0)) return 0;
+            OrderPtr order = allocateOrder(owner, price, qty, side, type);
+            MatchOutcome outcome = engine.matchOrder(order);
+            ++stats.ordersSubmitted;
+            for (const Fill& fill : engine.getLastFills()) {
+                ledger.apply(fill.takerOwnerID, fill.takerSide, fill.price, fill.qty);
+                ledger.apply(fill.makerOwnerID, fill.takerSide == Side::Buy ? Side::Sell : Side::Buy, fill.price, fill.qty);
+                ++stats.fills;
+                stats.volume += fill.qty;
+                stats.lastTradePrice = fill.price;
+                if (orderSlots[fill.makerOrderID - 1].getQty() == 0) {
+                    forgetOrder(fill.makerOwnerID, fill.makerOrderID);
+                    releaseOrder(fill.makerOrderID);
+                }
+            }
+            if (outcome && outcome->resting) return order->getOrderID();
+            releaseOrder(order->getOrderID());
+            return 0;
+        }
+
+        void cancel(OrderID& id) {
+            if (id == 0) return;
+            if (book.removeOrder(id) == RejectionReason::None) {
+                OrderPtr order = &orderSlots[id - 1];
+                order->setStatus(OrderLifecycle::afterCancelResting(order->getStatus()));
+                releaseOrder(id);
+                ++stats.cancels;
+            }
+            id = 0;
+        }
+
+        void stepMarketMakers(PriceTicks reference) {
+            for (uint32_t i = 0; i < makers.owner.size(); ++i) {
+                if (stats.steps % makers.requoteEvery[i] != i % makers.requoteEvery[i]) continue;
+                OwnerID owner = makers.owner[i];
+                cancel(makers.bidID[i]);
+                cancel(makers.askID[i]);
+                int64_t inventory = ledger.position[owner];
+                PriceTicks skew = static_cast<PriceTicks>(inventory * makers.halfSpread[i] / std::max<int64_t>(makers.maxInventory[i], 1));
+                if (inventory < makers.maxInventory[i]) {
+                    makers.bidID[i] = submit(owner, reference - makers.halfSpread[i] - skew, makers.quoteSize[i], Side::Buy, OrderType::Limit);
+                }
+                if (inventory > -makers.maxInventory[i]) {
+                    makers.askID[i] = submit(owner, reference + makers.halfSpread[i] - skew, makers.quoteSize[i], Side::Sell, OrderType::Limit);
+                }
+            }
+        }
+
+        void stepMomentum() {
+            if (stats.lastTradePrice == 0) return;
+            double price = static_cast<double>(stats.lastTradePrice);
+            for (uint32_t i = 0; i < momentum.owner.size(); ++i) {
+                momentum.fastEma[i] += 0.2 * (price - momentum.fastEma[i]);
+                momentum.slowEma[i] += 0.02 * (price - momentum.slowEma[i]);
+                double signal = momentum.fastEma[i] - momentum.slowEma[i];
+                OwnerID owner = momentum.owner[i];
+                int64_t position = ledger.position[owner];
+                if (signal > momentum.threshold[i] && position < momentum.maxPosition[i]) {
+                    submit(owner, 0, momentum.clipSize[i], Side::Buy, OrderType::Market);
+                } else if (signal < -momentum.threshold[i] && position > -momentum.maxPosition[i]) {
+                    submit(owner, 0, momentum.clipSize[i], Side::Sell, OrderType::Market);
+                }
+            }
+        }
+
+        void stepNoise(PriceTicks reference) {
+            for (uint32_t i = 0; i < noise.owner.size(); ++i) {
+                if (!chance(noise.actThreshold[i])) continue;
+                uint64_t r = nextRandom();
+                Side side = r & 1 ? Side::Buy : Side::Sell;
+                PriceTicks offset = static_cast<PriceTicks>((r >> 8) % static_cast<uint64_t>(noise.maxOffset[i] + 1));
+                PriceTicks price = side == Side::Buy ? reference - offset : reference + offset;
+                Quantity qty = static_cast<Quantity>(1 + (r >> 32) % static_cast<uint64_t>(noise.maxQty[i]));
+                OrderID& slot = noise.liveIDs[i][noise.nextSlot[i]];
+                cancel(slot);
+                slot = submit(noise.owner[i], price, qty, side, OrderType::Limit);
+                noise.nextSlot[i] = static_cast<uint8_t>((noise.nextSlot[i] + 1) % NOISE_ORDERS);
+            }
+        }
+
+        void stepLiquidityTakers() {
+            for (uint32_t i = 0; i < takers.owner.size(); ++i) {
+                if (!chance(takers.actThreshold[i])) continue;
+                uint64_t r = nextRandom();
+                Side side = r & 1 ? Side::Buy : Side::Sell;
+                Quantity qty = static_cast<Quantity>(1 + (r >> 32) % static_cast<uint64_t>(takers.maxQty[i]));
+                submit(takers.owner[i], 0, qty, side, OrderType::Market);
+            }
+        }
+
+    public:
+        explicit AgentSimulation(const AgentSimulationConfig &config, const InstrumentSpec* instrument = nullptr)
+            : book(instrument),
+              engine(&stpPolicy, &book),
+              rngState(config.seed * 0x9E3779B97F4A7C15ull + 1),
+              initialPrice(config.initialPrice),
+              lastReference(config.initialPrice),
+              stepsPerDay(config.stepsPerDay) {
+            agentByOwner.push_back(AgentRef{AgentKind::Noise, 0});  // owner 0 is unused
+            for (uint32_t i = 0; i < config.marketMakers; ++i) {
+                makers.owner.push_back(registerAgent(AgentKind::MarketMaker, i));
+                makers.halfSpread.push_back(static_cast<PriceTicks>(1 + randomBelow(4)));
+                makers.quoteSize.push_back(static_cast<Quantity>(50 + randomBelow(150)));
+                makers.maxInventory.push_back(static_cast<int64_t>(500 + randomBelow(1500)));
+                makers.requoteEvery.push_back(static_cast<uint32_t>(1 + randomBelow(8)));
+                makers.bidID.push_back(0);
+                makers.askID.push_back(0);
+            }
+            for (uint32_t i = 0; i < config.momentumTraders; ++i) {
+                momentum.owner.push_back(registerAgent(AgentKind::Momentum, i));
+                momentum.fastEma.push_back(static_cast<double>(initialPrice));
+                momentum.slowEma.push_back(static_cast<double>(initialPrice));
+                momentum.threshold.push_back(0.5 + static_cast<double>(randomBelow(300)) / 100.0);
+                momentum.clipSize.push_back(static_cast<Quantity>(5 + randomBelow(45)));
+                momentum.maxPosition.push_back(static_cast<int64_t>(200 + randomBelow(800)));
+            }
+            for (uint32_t i = 0; i < config.noiseTraders; ++i) {
+                noise.owner.push_back(registerAgent(AgentKind::Noise, i));
+                noise.actThreshold.push_back(probability(0.05 + static_cast<double>(randomBelow(20)) / 100.0));
+                noise.maxOffset.push_back(static_cast<PriceTicks>(2 + randomBelow(20)));
+                noise.maxQty.push_back(static_cast<Quantity>(10 + randomBelow(90)));
+                noise.liveIDs.push_back({});
+                noise.nextSlot.push_back(0);
+            }
+            for (uint32_t i = 0; i < config.liquidityTakers; ++i) {
+                takers.owner.push_back(registerAgent(AgentKind::LiquidityTaker, i));
+                takers.actThreshold.push_back(probability(0.01 + static_cast<double>(randomBelow(5)) / 100.0));
+                takers.maxQty.push_back(static_cast<Quantity>(20 + randomBelow(180)));
+            }
+            ledger.resize(agentByOwner.size());
+        }
+
+        AgentSimulation(const AgentSimulation&) = delete;
+        AgentSimulation& operator=(const AgentSimulation&) = delete;
+
+        void step() {
+            PriceTicks reference = referencePrice();
+            stepMarketMakers(reference);
+            stepNoise(reference);
+            stepMomentum();
+            stepLiquidityTakers();
+            ++stats.steps;
+        }
+
+        void run(uint64_t steps) {
+            for (uint64_t i = 0; i < steps; ++i) step();
+        }
+
+        inline void runDays(uint32_t days) { run(days * stepsPerDay); }
+
+        inline size_t getAgentCount() const { return agentByOwner.size() - 1; }
+        inline AgentKind getAgentKind(OwnerID owner) const { return agentByOwner[owner].kind; }
+        inline const AgentLedger& getLedger() const { return ledger; }
+        inline const AgentSimulationStats& getStats() const { return stats; }
+        inline const Book& getBook() const { return book; }
+        inline size_t getOrderSlotCount() const { return orderSlots.size(); }
+};
@@ -0,0 +1,268 @@
+#pragma once
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+#include "models/matching_engine.hpp"
+
+struct HarnessCommand {
+    enum class Kind : uint8_t { Submit, Cancel };
+
+    Kind kind;
+    OrderID orderID;
+    OwnerID ownerID;
+    PriceTicks price;
+    Quantity qty;
+    Side side;
+    OrderType type;
+};
+
+struct Divergence {
+    size_t eventIndex;
+    std::string description;
+};
+
+struct DifferentialReport {
+    uint64_t eventsRun = 0;
+    std::optional<Divergence> divergence;
+    std::vector<HarnessCommand> minimalFailure;  // shrunk command sequence that still diverges
+};
+
+// Seeded command stream: limit and market orders around a drifting mid, plus cancels of
+// recent IDs (live or not) so the book stays bounded over long soaks. A few owners share
+// the flow so self-trade prevention fires.
+class HarnessCommandGenerator {
+    private:
+        static constexpr OrderID CANCEL_WINDOW = 64;
+
+        uint64_t state;
+        OrderID nextOrderID = 1;
+        PriceTicks mid;
+        PriceTicks spreadRange;
+
+        uint64_t next() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+    public:
+        HarnessCommandGenerator(uint64_t seed, PriceTicks mid_, PriceTicks spreadRange_)
+            : state(seed * 0x9E3779B97F4A7C15ull + 1), mid(mid_), spreadRange(spreadRange_) {}
+
+        HarnessCommand operator()() {
+            uint64_t r = next();
+            if (r % 10 < 4 && nextOrderID > 1) {
+                OrderID window = std::min<OrderID>(nextOrderID - 1, CANCEL_WINDOW);
+                OrderID target = static_cast<OrderID>(nextOrderID - 1 - (r >> 8) % window);
+                return HarnessCommand{HarnessCommand::Kind::Cancel, target, 0, 0, 0, Side::Buy, OrderType::Limit};
+            }
+            Side side = (r >> 4) & 1 ? Side::Buy : Side::Sell;
+            OrderType type = (r >> 5) % 10 == 0 ? OrderType::Market : OrderType::Limit;
+            PriceTicks offset = static_cast<PriceTicks>((r >> 12) % static_cast<uint64_t>(spreadRange));
+            PriceTicks price = type == OrderType::Market ? 0 : (side == Side::Buy ? mid - offset + 2 : mid + offset - 2);
+            Quantity qty = static_cast<Quantity>(1 + (r >> 24) % 50);
+            OwnerID owner = static_cast<OwnerID>(1 + (r >> 32) % 6);
+            if ((r >> 40) % 64 == 0) {
+                mid += (r >> 46) & 1 ? 1 : -1;
+            }
+            return HarnessCommand{HarnessCommand::Kind::Submit, nextOrderID++, owner, price, qty, side, type};
+        }
+};
+
+// Drives a reference and a candidate book through identical commands and compares them
+// after every event: incoming/cancel outcome, the event's fills, best prices and the
+// order at each queue head are checked each step, every live order's status and qty every fullCheckInterval
+// steps. On divergence the failing prefix is shrunk (ddmin) to a minimal reproducer.
+template <typename ReferenceBook, typename CandidateBook>
+class DifferentialHarness {
+    private:
+        template <typename Book>
+        struct Lane {
+            Book book;
+            BasicMatchingEngine<Book> engine;
+            std::deque<Order> storage;
+            std::vector<OrderPtr> byID;
+
+            Lane(const InstrumentSpec* instrument, STPPolicy* stpPolicy)
+                : book(instrument), engine(stpPolicy, &book) {}
+
+            OrderPtr find(OrderID id) const { return id < byID.size() ? byID[id] : nullptr; }
+
+            RejectionReason apply(const HarnessCommand &command) {
+                if (command.kind == HarnessCommand::Kind::Cancel) {
+                    RejectionReason result = book.removeOrder(command.orderID);
+                    if (result == RejectionReason::None) {
+                        OrderPtr order = find(command.orderID);
+                        order->setStatus(OrderLifecycle::afterCancelResting(order->getStatus()));
+                    }
+                    return result;
+                }
+                OrderPtr order = &storage.emplace_back(
+                    command.orderID, command.ownerID, command.price, command.qty, command.side, command.type, storage.size()
+                );
+                if (byID.size() <= command.orderID) byID.resize(command.orderID + 1, nullptr);
+                byID[command.orderID] = order;
+                engine.matchOrder(order);
+                return RejectionReason::None;
+            }
+        };
+
+        const InstrumentSpec* instrument;
+        STPPolicy* stpPolicy;
+        uint64_t seed;
+        uint32_t fullCheckInterval;
+
+        static std::string describeOrder(const char* label, const OrderPtr &order) {
+            if (!order) return std::string(label) + "=none";
+            return std::string(label) + "=#" + std::to_string(order->getOrderID())
+                + " qty " + std::to_string(order->getQty())
+                + " status " + std::to_string(static_cast<int>(order->getStatus()));
+        }
+
+        static bool sameOrder(const OrderPtr &a, const OrderPtr &b) {
+            if (!a || !b) return a == b;
+            return a->getOrderID() == b->getOrderID() && a->getQty() == b->getQty() && a->getStatus() == b->getStatus();
+        }
+
+        template <typename FillT>
+        static bool sameFill(const FillT &a, const FillT &b) {
+            return a.makerOrderID == b.makerOrderID && a.takerOrderID == b.takerOrderID && a.price == b.price && a.qty == b.qty;
+        }
+
+        template <typename FillT>
+        static std::string describeFill(const FillT &fill) {
+            return "#" + std::to_string(fill.takerOrderID) + " x #" + std::to_string(fill.makerOrderID)
+                + " " + std::to_string(fill.qty) + " @ " + std::to_string(fill.price);
+        }
+
+        static std::optional<std::string> compareStep(
+            const Lane<ReferenceBook> &reference,
+            const Lane<CandidateBook> &candidate,
+            const HarnessCommand &command,
+            RejectionReason referenceResult,
+            RejectionReason candidateResult
+        ) {
+            if (referenceResult != candidateResult) {
+                return "cancel of #" + std::to_string(command.orderID) + " returned "
+                    + std::to_string(static_cast<int>(referenceResult)) + " vs "
+                    + std::to_string(static_cast<int>(candidateResult));
+            }
+            auto referenceFills = reference.engine.getLastFills();
+            auto candidateFills = candidate.engine.getLastFills();
+            if (referenceFills.size() != candidateFills.size()) {
+                return "fill count " + std::to_string(referenceFills.size()) + " vs " + std::to_string(candidateFills.size());
+            }
+            for (size_t i = 0; i < referenceFills.size(); ++i) {
+                if (!sameFill(referenceFills[i], candidateFills[i])) {
+                    return "fill " + std::to_string(i) + " " + describeFill(referenceFills[i]) + " vs " + describeFill(candidateFills[i]);
+                }
+            }
+            OrderPtr referenceOrder = reference.find(command.orderID);
+            OrderPtr candidateOrder = candidate.find(command.orderID);
+            if (!sameOrder(referenceOrder, candidateOrder)) {
+                return describeOrder("reference", referenceOrder) + " vs " + describeOrder("candidate", candidateOrder);
+            }
+            if (reference.book.getBestBid() != candidate.book.getBestBid()
+                || reference.book.getBestAsk() != candidate.book.getBestAsk()) {
+                return std::string("best prices differ");
+            }
+            for (Side side : {Side::Buy, Side::Sell}) {
+                OrderPtr referenceHead = reference.book.getMatchedOrder(side);
+                OrderPtr candidateHead = candidate.book.getMatchedOrder(side);
+                if (!sameOrder(referenceHead, candidateHead)) {
+                    return "queue head " + describeOrder("reference", referenceHead) + " vs " + describeOrder("candidate", candidateHead);
+                }
+            }
+            return std::nullopt;
+        }
+
+        static std::optional<std::string> compareAll(const Lane<ReferenceBook> &reference, const Lane<CandidateBook> &candidate) {
+            for (OrderID id = 0; id < reference.byID.size(); ++id) {
+                OrderPtr referenceOrder = reference.find(id);
+                OrderPtr candidateOrder = candidate.find(id);
+                if (!sameOrder(referenceOrder, candidateOrder)) {
+                    return "full check " + describeOrder("reference", referenceOrder) + " vs " + describeOrder("candidate", candidateOrder);
+                }
+                if (referenceOrder && reference.book.doesOrderExist(id) != candidate.book.doesOrderExist(id)) {
+                    return "full check: #" + std::to_string(id) + " resting in only one book";
+                }
+            }
+            return std::nullopt;
+        }
+
+    public:
+        DifferentialHarness(const InstrumentSpec* instrument_, STPPolicy* stpPolicy_, uint64_t seed_, uint32_t fullCheckInterval_ = 4096)
+            : instrument(instrument_), stpPolicy(stpPolicy_), seed(seed_), fullCheckInterval(fullCheckInterval_) {}
+
+        // Replays commands on fresh books; returns the first divergence, if any.
+        std::optional<Divergence> replay(const std::vector<HarnessCommand> &commands, uint32_t checkInterval) const {
+            Lane<ReferenceBook> reference(instrument, stpPolicy);
+            Lane<CandidateBook> candidate(instrument, stpPolicy);
+            for (size_t i = 0; i < commands.size(); ++i) {
+                RejectionReason referenceResult = reference.apply(commands[i]);
+                RejectionReason candidateResult = candidate.apply(commands[i]);
+                auto mismatch = compareStep(reference, candidate, commands[i], referenceResult, candidateResult);
+                if (!mismatch && (i + 1) % checkInterval == 0) {
+                    mismatch = compareAll(reference, candidate);
+                }
+                if (mismatch) {
+                    return Divergence{i, *mismatch};
+                }
+            }
+            if (auto mismatch = compareAll(reference, candidate)) {
+                return Divergence{commands.empty() ? 0 : commands.size() - 1, *mismatch};
+            }
+            return std::nullopt;
+        }
+
+        std::vector<HarnessCommand> shrink(std::vector<HarnessCommand> commands) const {
+            size_t chunk = commands.size() / 2;
+            while (chunk > 0) {
+                bool removedAny = false;
+                for (size_t start = 0; start < commands.size(); ) {
+                    std::vector<HarnessCommand> candidate;
+                    candidate.reserve(commands.size());
+                    candidate.insert(candidate.end(), commands.begin(), commands.begin() + start);
+                    candidate.insert(candidate.end(), commands.begin() + std::min(start + chunk, commands.size()), commands.end());
+                    if (replay(candidate, 1)) {
+                        commands = std::move(candidate);
+                        removedAny = true;
+                    } else {
+                        start += chunk;
+                    }
+                }
+                if (!removedAny) chunk /= 2;
+            }
+            return commands;
+        }
+
+        // The stream is regenerated from the seed for shrinking, so the hot loop keeps no history.
+        DifferentialReport run(uint64_t eventCount, PriceTicks mid = 5000, PriceTicks spreadRange = 40) const {
+            DifferentialReport report;
+            HarnessCommandGenerator generate(seed, mid, spreadRange);
+            Lane<ReferenceBook> reference(instrument, stpPolicy);
+            Lane<CandidateBook> candidate(instrument, stpPolicy);
+            for (uint64_t i = 0; i < eventCount; ++i) {
+                HarnessCommand command = generate();
+                RejectionReason referenceResult = reference.apply(command);
+                RejectionReason candidateResult = candidate.apply(command);
+                auto mismatch = compareStep(reference, candidate, command, referenceResult, candidateResult);
+                if (!mismatch && ((i + 1) % fullCheckInterval == 0 || i + 1 == eventCount)) {
+                    mismatch = compareAll(reference, candidate);
+                }
+                report.eventsRun = i + 1;
+                if (mismatch) {
+                    report.divergence = Divergence{i, *mismatch};
+                    HarnessCommandGenerator regenerate(seed, mid, spreadRange);
+                    std::vector<HarnessCommand> prefix(i + 1);
+                    for (auto& prefixCommand : prefix) prefixCommand = regenerate();
+                    report.minimalFailure = shrink(std::move(prefix));
+                    return report;
+                }
+            }
+            return report;
+        }
+};
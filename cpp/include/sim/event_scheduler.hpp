@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "models/order.hpp"
+
+// Monotone priority queue on (time, sequence): pushed times must not be earlier than the
+// last popped one, which holds for a simulation clock. Entries sit in 65 buckets keyed by
+// the highest bit where their time differs from the last popped time, so push is O(1) and
+// each entry is moved at most 64 times over its life. Equal times pop in push order.
+template <typename Payload>
+class RadixHeap {
+    private:
+        struct Entry {
+            Timestamp time;
+            uint64_t sequence;
+            Payload payload;
+        };
+
+        std::array<std::vector<Entry>, 65> buckets;
+        size_t head = 0;            // next entry to pop from bucket 0
+        Timestamp last = 0;
+        uint64_t nextSequence = 0;
+        size_t count = 0;
+
+        inline size_t bucketOf(Timestamp time) const {
+            return time == last ? 0 : 64 - std::countl_zero(time ^ last);
+        }
+
+        void refill() {
+            buckets[0].clear();
+            head = 0;
+            size_t i = 1;
+            while (buckets[i].empty()) ++i;
+            auto& source = buckets[i];
+            last = std::min_element(source.begin(), source.end(), [](const Entry &a, const Entry &b) {
+                return a.time < b.time;
+            })->time;
+            for (Entry& entry : source) {
+                buckets[bucketOf(entry.time)].push_back(std::move(entry));
+            }
+            source.clear();
+            // Entries redistributed from one bucket are not in push order; later pushes at the
+            // same time carry higher sequences and append behind them.
+            std::sort(buckets[0].begin(), buckets[0].end(), [](const Entry &a, const Entry &b) {
+                return a.sequence < b.sequence;
+            });
+        }
+
+    public:
+        inline bool empty() const { return count == 0; }
+        inline size_t size() const { return count; }
+        inline Timestamp lastPopped() const { return last; }
+
+        // Returns false if time is earlier than the last popped time.
+        bool push(Timestamp time, Payload payload) {
+            if (time < last) return false;
+            buckets[bucketOf(time)].push_back(Entry{time, nextSequence++, std::move(payload)});
+            ++count;
+            return true;
+        }
+
+        Timestamp topTime() {
+            if (head == buckets[0].size()) refill();
+            return buckets[0][head].time;
+        }
+
+        Payload pop() {
+            if (head == buckets[0].size()) refill();
+            --count;
+            return std::move(buckets[0][head++].payload);
+        }
+};
+
+// Simulated time in nanoseconds. Orders created through stamp() carry the clock's current
+// time, so queue priority in the book follows simulated arrival rather than wall time.
+class SimClock {
+    private:
+        Timestamp current = 0;
+
+    public:
+        static constexpr Timestamp NANOS_PER_SECOND = 1'000'000'000;
+
+        static constexpr Timestamp fromSeconds(double seconds) {
+            return static_cast<Timestamp>(seconds * NANOS_PER_SECOND);
+        }
+
+        inline Timestamp now() const { return current; }
+
+        // Time never moves backwards.
+        inline void advanceTo(Timestamp time) { current = std::max(current, time); }
+
+        inline Order stamp(OrderID orderID, OwnerID ownerID, PriceTicks price, Quantity qty, Side side, OrderType type) const {
+            return Order(orderID, ownerID, price, qty, side, type, current);
+        }
+};
+
+// Per-owner one-way network latency and exchange-side processing time, plus seeded uniform
+// jitter on the network leg. Draws depend only on the seed and call order.
+class LatencyModel {
+    private:
+        std::vector<Timestamp> network;
+        std::vector<Timestamp> processing;
+        Timestamp jitter;
+        uint64_t state;
+
+        uint64_t nextRandom() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        Timestamp networkLeg(OwnerID owner) {
+            Timestamp base = owner < network.size() ? network[owner] : 0;
+            return jitter ? base + nextRandom() % (jitter + 1) : base;
+        }
+
+    public:
+        explicit LatencyModel(uint64_t seed = 1, Timestamp jitter_ = 0)
+            : jitter(jitter_), state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+
+        void setLatency(OwnerID owner, Timestamp networkLatency, Timestamp processingLatency) {
+            if (network.size() <= owner) {
+                network.resize(owner + 1, 0);
+                processing.resize(owner + 1, 0);
+            }
+            network[owner] = networkLatency;
+            processing[owner] = processingLatency;
+        }
+
+        // Time at which a message sent at sentAt is handled by the exchange.
+        Timestamp arrivalAtExchange(OwnerID owner, Timestamp sentAt) {
+            Timestamp processingTime = owner < processing.size() ? processing[owner] : 0;
+            return sentAt + networkLeg(owner) + processingTime;
+        }
+
+        // Time at which a report published at publishedAt reaches the owner.
+        Timestamp arrivalAtOwner(OwnerID owner, Timestamp publishedAt) {
+            return publishedAt + networkLeg(owner);
+        }
+};
+
+// Discrete-event loop: pops events in (time, schedule order), advances the clock to each
+// one and hands it to the handler, which may schedule further events at or after now().
+template <typename Event>
+class EventScheduler {
+    private:
+        RadixHeap<Event> queue;
+        SimClock clock;
+        uint64_t processed = 0;
+
+    public:
+        inline const SimClock& getClock() const { return clock; }
+        inline Timestamp now() const { return clock.now(); }
+        inline size_t pending() const { return queue.size(); }
+        inline uint64_t getProcessedCount() const { return processed; }
+
+        inline bool schedule(Timestamp at, Event event) { return queue.push(at, std::move(event)); }
+        inline bool scheduleAfter(Timestamp delay, Event event) { return queue.push(clock.now() + delay, std::move(event)); }
+
+        // Runs every event with time <= endTime; returns the number handled.
+        template <typename Handler>
+        uint64_t runUntil(Timestamp endTime, Handler &&handler) {
+            uint64_t handled = 0;
+            while (!queue.empty() && queue.topTime() <= endTime) {
+                clock.advanceTo(queue.topTime());
+                Event event = queue.pop();
+                handler(clock.now(), event);
+                ++handled;
+            }
+            clock.advanceTo(endTime);
+            processed += handled;
+            return handled;
+        }
+
+        template <typename Handler>
+        uint64_t runAll(Handler &&handler) {
+            uint64_t handled = 0;
+            while (!queue.empty()) {
+                clock.advanceTo(queue.topTime());
+                Event event = queue.pop();
+                handler(clock.now(), event);
+                ++handled;
+            }
+            processed += handled;
+            return handled;
+        }
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+#include "models/matching_engine.hpp"
+#include "utils/thread_pool.hpp"
+
+// An independent fork of a book with its own copies of the orders, built by the book's
+// cloning constructor from one pass over the source's entries and one over its levels.
+// Handles taken on the source resolve to the same orders in the fork.
+class BookFork {
+    private:
+        std::vector<Order> orders;
+        LimitOrderBook book;
+
+    public:
+        explicit BookFork(const LimitOrderBook &source) : book(source, orders) {}
+
+        BookFork(const BookFork&) = delete;
+        BookFork& operator=(const BookFork&) = delete;
+
+        inline LimitOrderBook& getBook() { return book; }
+        inline size_t getRestingOrderCount() const { return orders.size(); }
+};
+
+class WhatIfRunner {
+    private:
+        STPPolicy* stpPolicy;
+        ThreadPool pool;
+
+    public:
+        WhatIfRunner(STPPolicy* policy, size_t threadCount = std::thread::hardware_concurrency())
+            : stpPolicy(policy), pool(threadCount) {}
+
+        // Runs scenario(forkIndex, book, engine) for each fork on the pool. Every fork has its own
+        // book, order storage and MatchingEngine and is cloned from source on its worker, so
+        // source must not change during the run; stpPolicy must be safe to share read-only.
+        template <typename Scenario>
+        void run(const LimitOrderBook &source, size_t forkCount, Scenario &&scenario) {
+            pool.parallelFor(forkCount, [&](size_t forkIndex) {
+                BookFork fork(source);
+                MatchingEngine engine(stpPolicy, &fork.getBook());
+                scenario(forkIndex, fork.getBook(), engine);
+            });
+        }
+};
@@ -0,0 +1,259 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "models/order.hpp"
+
+enum class CsvLoadError : uint8_t {
+    None,               // every row loaded
+    OpenFailed,         // file could not be opened or mapped
+    MissingColumn,      // header lacks a required column
+    BadField,           // a field is empty or does not parse
+    PriceNotOnTick      // price is not a whole number of ticks
+};
+
+struct CsvLoadResult {
+    CsvLoadError error = CsvLoadError::None;
+    size_t line = 0;            // 1-based line of the first error
+    size_t ordersLoaded = 0;
+};
+
+// Exact decimal price to tick conversion. The tick size is held as an integer count of
+// 10^-scale units ("0.05" is 5 at scale 2), and prices are parsed into the same units
+// without going through floating point, so a price converts only if it is an exact
+// multiple of the tick.
+class DecimalTickConverter {
+    private:
+        static constexpr uint32_t MAX_SCALE = 12;
+
+        int64_t tickUnits = 1;
+        uint32_t scale = 0;
+
+        static std::optional<std::pair<int64_t, uint32_t>> parseDecimal(std::string_view text, uint32_t maxScale) {
+            bool negative = !text.empty() && text.front() == '-';
+            if (negative) text.remove_prefix(1);
+            size_t dot = text.find('.');
+            std::string_view whole = text.substr(0, dot);
+            std::string_view fraction = dot == std::string_view::npos ? std::string_view{} : text.substr(dot + 1);
+            while (fraction.size() > maxScale && fraction.back() == '0') fraction.remove_suffix(1);
+            if ((whole.empty() && fraction.empty()) || fraction.size() > maxScale) return std::nullopt;
+
+            int64_t value = 0;
+            for (std::string_view part : {whole, fraction}) {
+                for (char c : part) {
+                    if (c < '0' || c > '9') return std::nullopt;
+                    if (__builtin_mul_overflow(value, 10, &value) || __builtin_add_overflow(value, c - '0', &value)) return std::nullopt;
+                }
+            }
+            return std::make_pair(negative ? -value : value, static_cast<uint32_t>(fraction.size()));
+        }
+
+        static bool rescale(int64_t &value, uint32_t from, uint32_t to) {
+            for (; from < to; ++from) {
+                if (__builtin_mul_overflow(value, 10, &value)) return false;
+            }
+            return true;
+        }
+
+    public:
+        DecimalTickConverter() = default;
+
+        // Returns nullopt unless tickSize is a positive decimal with at most 12 decimals.
+        static std::optional<DecimalTickConverter> fromTickSize(std::string_view tickSize) {
+            auto parsed = parseDecimal(tickSize, MAX_SCALE);
+            if (!parsed || parsed->first <= 0) return std::nullopt;
+            DecimalTickConverter converter;
+            converter.tickUnits = parsed->first;
+            converter.scale = parsed->second;
+            return converter;
+        }
+
+        // Sets error to BadField or PriceNotOnTick on failure.
+        std::optional<PriceTicks> toTicks(std::string_view price, CsvLoadError &error) const {
+            auto parsed = parseDecimal(price, scale);
+            if (!parsed) {
+                // More significant decimals than the tick has: off tick if it is a number at all.
+                error = parseDecimal(price, MAX_SCALE * 2) ? CsvLoadError::PriceNotOnTick : CsvLoadError::BadField;
+                return std::nullopt;
+            }
+            int64_t units = parsed->first;
+            if (!rescale(units, parsed->second, scale)) {
+                error = CsvLoadError::BadField;
+                return std::nullopt;
+            }
+            if (units % tickUnits != 0) {
+                error = CsvLoadError::PriceNotOnTick;
+                return std::nullopt;
+            }
+            return units / tickUnits;
+        }
+};
+
+// Read-only mmap of a whole file.
+class MappedFile {
+    private:
+        const char* data = nullptr;
+        size_t length = 0;
+
+    public:
+        explicit MappedFile(const char* path) {
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0) return;
+            struct stat info;
+            if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+                void* mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    data = static_cast<const char*>(mapped);
+                    length = static_cast<size_t>(info.st_size);
+                    ::madvise(mapped, length, MADV_SEQUENTIAL);
+                }
+            }
+            ::close(fd);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+            if (data) ::munmap(const_cast<char*>(data), length);
+        }
+
+        inline bool isOpen() const { return data != nullptr; }
+        inline std::string_view view() const { return {data, length}; }
+};
+
+// Loads orders from CSV with a header row naming at least order_id, owner_id, side,
+// type, price, qty and timestamp, in any order; other columns are skipped. Side is
+// B/BUY or S/SELL, type L/LIMIT or M/MARKET (first letter decides, any case). Market
+// order prices may be empty. Lines are split with memchr, which glibc vectorises, and
+// integers are parsed with std::from_chars.
+class CsvOrderLoader {
+    private:
+        enum Column : size_t { OrderIDColumn, OwnerIDColumn, SideColumn, TypeColumn, PriceColumn, QtyColumn, TimestampColumn, COLUMN_COUNT };
+        static constexpr std::array<std::string_view, COLUMN_COUNT> COLUMN_NAMES = {
+            "order_id", "owner_id", "side", "type", "price", "qty", "timestamp"
+        };
+        static constexpr size_t SKIP = SIZE_MAX;
+
+        DecimalTickConverter converter;
+
+        static std::string_view nextLine(std::string_view &rest) {
+            const char* end = static_cast<const char*>(std::memchr(rest.data(), '\n', rest.size()));
+            size_t length = end ? static_cast<size_t>(end - rest.data()) : rest.size();
+            std::string_view line = rest.substr(0, length);
+            rest.remove_prefix(end ? length + 1 : length);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            return line;
+        }
+
+        // Fields are a few bytes long, so a plain loop beats a memchr call per field.
+        static std::string_view nextField(std::string_view &line) {
+            size_t length = 0;
+            while (length < line.size() && line[length] != ',') ++length;
+            std::string_view field = line.substr(0, length);
+            line.remove_prefix(length < line.size() ? length + 1 : length);
+            return field;
+        }
+
+        template <typename T>
+        static bool parseInteger(std::string_view field, T &value) {
+            auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+            return ec == std::errc() && end == field.data() + field.size();
+        }
+
+        static bool parseSide(std::string_view field, Side &side) {
+            if (field.empty()) return false;
+            char c = static_cast<char>(field.front() | 0x20);
+            if (c == 'b') side = Side::Buy;
+            else if (c == 's') side = Side::Sell;
+            else return false;
+            return true;
+        }
+
+        static bool parseType(std::string_view field, OrderType &type) {
+            if (field.empty()) return false;
+            char c = static_cast<char>(field.front() | 0x20);
+            if (c == 'l') type = OrderType::Limit;
+            else if (c == 'm') type = OrderType::Market;
+            else return false;
+            return true;
+        }
+
+    public:
+        explicit CsvOrderLoader(DecimalTickConverter converter_ = {}) : converter(converter_) {}
+
+        // Appends parsed orders to out. Stops at the first bad row; rows before it stay loaded.
+        CsvLoadResult load(std::string_view text, std::vector<Order> &out) const {
+            CsvLoadResult result;
+            std::array<size_t, 16> columnOf;     // field index -> Column, for the first 16 fields
+            columnOf.fill(SKIP);
+            std::string_view header = nextLine(text);
+            result.line = 1;
+            uint32_t found = 0;
+            for (size_t field = 0; !header.empty() && field < columnOf.size(); ++field) {
+                std::string_view name = nextField(header);
+                for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+                    if (name == COLUMN_NAMES[c] && !(found & (1u << c))) {
+                        columnOf[field] = c;
+                        found |= 1u << c;
+                    }
+                }
+            }
+            if (found != (1u << COLUMN_COUNT) - 1) {
+                result.error = CsvLoadError::MissingColumn;
+                return result;
+            }
+
+            std::array<std::string_view, COLUMN_COUNT> fields;
+            while (!text.empty()) {
+                std::string_view line = nextLine(text);
+                ++result.line;
+                if (line.empty()) continue;
+                fields.fill({});
+                for (size_t field = 0; !line.empty() && field < columnOf.size(); ++field) {
+                    std::string_view value = nextField(line);
+                    if (columnOf[field] != SKIP) fields[columnOf[field]] = value;
+                }
+
+                OrderID orderID;
+                OwnerID ownerID;
+                Side side;
+                OrderType type;
+                Quantity qty;
+                Timestamp timestamp;
+                if (!parseInteger(fields[OrderIDColumn], orderID) || !parseInteger(fields[OwnerIDColumn], ownerID)
+                    || !parseSide(fields[SideColumn], side) || !parseType(fields[TypeColumn], type)
+                    || !parseInteger(fields[QtyColumn], qty) || !parseInteger(fields[TimestampColumn], timestamp)) {
+                    result.error = CsvLoadError::BadField;
+                    return result;
+                }
+                PriceTicks price = 0;
+                if (type == OrderType::Limit || !fields[PriceColumn].empty()) {
+                    auto ticks = converter.toTicks(fields[PriceColumn], result.error);
+                    if (!ticks) return result;
+                    price = *ticks;
+                }
+                out.emplace_back(orderID, ownerID, price, qty, side, type, timestamp);
+                ++result.ordersLoaded;
+            }
+            result.line = 0;
+            return result;
+        }
+
+        CsvLoadResult loadFile(const char* path, std::vector<Order> &out) const {
+            MappedFile file(path);
+            if (!file.isOpen()) {
+                CsvLoadResult result;
+                result.error = CsvLoadError::OpenFailed;
+                return result;
+            }
+            return load(file.view(), out);
+        }
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Binary indexed tree of int64 values over [0, size()), growing at the end. Point updates,
+// appends and prefix sums each touch O(log n) nodes; node i (1-based) covers the
+// i & -i values ending at i.
+template <typename Allocator = std::allocator<int64_t>>
+class FenwickTree {
+    private:
+        std::vector<int64_t, Allocator> tree;
+
+        static constexpr size_t lowBit(size_t i) { return i & (~i + 1); }
+
+    public:
+        inline size_t size() const { return tree.size(); }
+        inline size_t capacity() const { return tree.capacity(); }
+        inline void clear() { tree.clear(); }
+        inline void reserve(size_t count) { tree.reserve(count); }
+
+        // Returns the index of the new value.
+        size_t append(int64_t value) {
+            size_t node = tree.size() + 1;
+            tree.push_back(value + prefix(node - 1) - prefix(node - lowBit(node)));
+            return node - 1;
+        }
+
+        void add(size_t index, int64_t delta) {
+            for (size_t node = index + 1; node <= tree.size(); node += lowBit(node)) {
+                tree[node - 1] += delta;
+            }
+        }
+
+        // Sum of the first count values.
+        int64_t prefix(size_t count) const {
+            int64_t sum = 0;
+            for (size_t node = count; node > 0; node -= lowBit(node)) {
+                sum += tree[node - 1];
+            }
+            return sum;
+        }
+
+        // Replaces the contents with valueOf(*it) for each element of [first, last) in O(n).
+        template <typename It, typename Fn>
+        void assign(It first, It last, Fn &&valueOf) {
+            tree.clear();
+            for (; first != last; ++first) tree.push_back(valueOf(*first));
+            for (size_t node = 1; node <= tree.size(); ++node) {
+                size_t parent = node + lowBit(node);
+                if (parent <= tree.size()) tree[parent - 1] += tree[node - 1];
+            }
+        }
+};
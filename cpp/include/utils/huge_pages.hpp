@@ -0,0 +1,299 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <sched.h>
+#include <sys/mman.h>
+#include "models/order.hpp"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+enum class PageBacking : uint8_t {
+    None,           // nothing could be mapped
+    Regular,        // 4KB pages
+    Transparent,    // 4KB mapping advised for transparent huge pages
+    Huge2MB,        // hugetlbfs 2MB pages
+    Huge1GB         // hugetlbfs 1GB pages
+};
+
+// Anonymous mapping backed by the largest page size that can be had, starting at the
+// preferred one: hugetlbfs 1GB, then 2MB (both need pages reserved in
+// /proc/sys/vm/nr_hugepages or the per-size sysfs knobs), then a 2MB-aligned regular
+// mapping advised with MADV_HUGEPAGE. The size is rounded up to the page size used.
+//
+// Pages are placed on the NUMA node of the thread that first touches them, so prefault()
+// should be called from the matching thread after it has been pinned.
+class HugePageRegion {
+    private:
+        static constexpr size_t SMALL_PAGE = size_t{4} << 10;
+        static constexpr size_t HUGE_2MB = size_t{2} << 20;
+        static constexpr size_t HUGE_1GB = size_t{1} << 30;
+
+        std::byte* data = nullptr;
+        size_t length = 0;
+        PageBacking backing = PageBacking::None;
+        int node = -1;
+
+        static inline size_t roundUp(size_t bytes, size_t page) { return (bytes + page - 1) & ~(page - 1); }
+
+        bool tryHugeTlb(size_t bytes, size_t page, PageBacking kind) {
+            int sizeFlag = std::countr_zero(page) << MAP_HUGE_SHIFT;
+            size_t rounded = roundUp(bytes, page);
+            void* mapped = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | sizeFlag, -1, 0);
+            if (mapped == MAP_FAILED) return false;
+            data = static_cast<std::byte*>(mapped);
+            length = rounded;
+            backing = kind;
+            return true;
+        }
+
+        // Over-maps by one huge page and trims both ends so the region starts on a 2MB
+        // boundary, which transparent huge pages need.
+        void mapTransparent(size_t bytes) {
+            size_t rounded = roundUp(bytes, HUGE_2MB);
+            void* mapped = ::mmap(nullptr, rounded + HUGE_2MB, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED) return;
+            auto address = reinterpret_cast<uintptr_t>(mapped);
+            uintptr_t aligned = roundUp(address, HUGE_2MB);
+            if (aligned > address) ::munmap(mapped, aligned - address);
+            size_t tail = address + rounded + HUGE_2MB - (aligned + rounded);
+            if (tail) ::munmap(reinterpret_cast<void*>(aligned + rounded), tail);
+            data = reinterpret_cast<std::byte*>(aligned);
+            length = rounded;
+            backing = ::madvise(data, length, MADV_HUGEPAGE) == 0 ? PageBacking::Transparent : PageBacking::Regular;
+        }
+
+    public:
+        explicit HugePageRegion(size_t bytes, PageBacking preferred = PageBacking::Huge2MB) {
+            if (bytes == 0) return;
+            if (preferred >= PageBacking::Huge1GB && tryHugeTlb(bytes, HUGE_1GB, PageBacking::Huge1GB)) return;
+            if (preferred >= PageBacking::Huge2MB && tryHugeTlb(bytes, HUGE_2MB, PageBacking::Huge2MB)) return;
+            mapTransparent(bytes);
+        }
+
+        HugePageRegion(const HugePageRegion&) = delete;
+        HugePageRegion& operator=(const HugePageRegion&) = delete;
+
+        ~HugePageRegion() {
+            if (data) ::munmap(data, length);
+        }
+
+        inline std::byte* begin() const { return data; }
+        inline size_t size() const { return length; }
+        inline PageBacking getBacking() const { return backing; }
+        inline bool contains(const void* p) const {
+            auto* byte = static_cast<const std::byte*>(p);
+            return byte >= data && byte < data + length;
+        }
+
+        // NUMA node the pages were faulted in on, or -1 before prefault().
+        inline int getNode() const { return node; }
+
+        // Faults every page in from the calling thread so later allocations never take a
+        // page fault, and records the thread's NUMA node.
+        void prefault() {
+            if (!data) return;
+            bool populated = false;
+#ifdef MADV_POPULATE_WRITE
+            populated = ::madvise(data, length, MADV_POPULATE_WRITE) == 0;
+#endif
+            if (!populated) {
+                for (size_t offset = 0; offset < length; offset += SMALL_PAGE) {
+                    *reinterpret_cast<volatile std::byte*>(data + offset) = std::byte{0};
+                }
+            }
+            unsigned cpu = 0;
+            unsigned numaNode = 0;
+            node = ::getcpu(&cpu, &numaNode) == 0 ? static_cast<int>(numaNode) : -1;
+        }
+};
+
+// Size-class allocator over a HugePageRegion for the book's list nodes, index nodes and
+// bucket/level arrays. Requests up to 512 bytes use 16-byte classes, larger ones
+// power-of-two classes; freed blocks go to their class's free list and are reused before
+// the bump pointer moves. When the region is exhausted, or the alignment exceeds 16,
+// allocation falls through to operator new and is counted.
+//
+// An arena belongs to one thread: install() sets the calling thread's arena only, so each
+// matching thread installs its own and never shares free lists. A block freed on another
+// thread is pushed onto the owning arena's lock-free remote list, which the owner folds
+// into its free lists when one runs dry. Live arenas are found through a fixed registry
+// of MAX_ARENAS slots; an arena created when it is full hands every request to operator new.
+class HugePageArena {
+    private:
+        static constexpr size_t GRANULE = 16;
+        static constexpr size_t SMALL_LIMIT = 512;
+        static constexpr size_t SMALL_CLASSES = SMALL_LIMIT / GRANULE;
+        static constexpr size_t CLASS_COUNT = SMALL_CLASSES + 64;
+        static constexpr size_t MAX_ARENAS = 64;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct RemoteBlock {
+            RemoteBlock* next;
+            size_t sizeClass;
+        };
+
+        HugePageRegion region;
+        size_t capacity = 0;        // region bytes the bump pointer may use; 0 if unregistered
+        size_t used = 0;
+        size_t fallbackCount = 0;
+        size_t registrySlot = MAX_ARENAS;
+        std::array<FreeBlock*, CLASS_COUNT> freeLists{};
+        std::atomic<RemoteBlock*> remoteFrees{nullptr};
+
+        static inline thread_local HugePageArena* installed = nullptr;
+        static inline std::array<std::atomic<HugePageArena*>, MAX_ARENAS> registry{};
+        static inline std::atomic<size_t> registryEnd{0};
+
+        static inline size_t classOf(size_t bytes) {
+            if (bytes <= SMALL_LIMIT) return (bytes + GRANULE - 1) / GRANULE - (bytes != 0);
+            return SMALL_CLASSES + std::bit_width(bytes - 1);
+        }
+
+        static inline size_t classSize(size_t sizeClass) {
+            if (sizeClass < SMALL_CLASSES) return (sizeClass + 1) * GRANULE;
+            return size_t{1} << (sizeClass - SMALL_CLASSES);
+        }
+
+        void registerArena() {
+            for (size_t slot = 0; slot < MAX_ARENAS; ++slot) {
+                HugePageArena* expected = nullptr;
+                if (!registry[slot].compare_exchange_strong(expected, this, std::memory_order_acq_rel)) continue;
+                size_t end = registryEnd.load(std::memory_order_relaxed);
+                while (end <= slot && !registryEnd.compare_exchange_weak(end, slot + 1, std::memory_order_acq_rel)) {}
+                registrySlot = slot;
+                capacity = region.size();
+                return;
+            }
+        }
+
+        void drainRemoteFrees() {
+            RemoteBlock* block = remoteFrees.exchange(nullptr, std::memory_order_acquire);
+            while (block) {
+                RemoteBlock* next = block->next;
+                size_t sizeClass = block->sizeClass;
+                freeLists[sizeClass] = new (block) FreeBlock{freeLists[sizeClass]};
+                block = next;
+            }
+        }
+
+    public:
+        explicit HugePageArena(size_t bytes, PageBacking preferred = PageBacking::Huge2MB) : region(bytes, preferred) {
+            if (region.begin()) registerArena();
+        }
+
+        HugePageArena(const HugePageArena&) = delete;
+        HugePageArena& operator=(const HugePageArena&) = delete;
+
+        ~HugePageArena() {
+            if (installed == this) installed = nullptr;
+            if (registrySlot != MAX_ARENAS) registry[registrySlot].store(nullptr, std::memory_order_release);
+        }
+
+        // Arena that HugePageAllocator draws from on the calling thread; nullptr makes it
+        // plain operator new. Install an arena on one thread only.
+        static inline void install(HugePageArena* arena) { installed = arena; }
+        static inline HugePageArena* current() { return installed; }
+
+        // Live arena whose region holds p, whichever thread owns it.
+        static HugePageArena* ownerOf(const void* p) {
+            size_t end = registryEnd.load(std::memory_order_acquire);
+            for (size_t slot = 0; slot < end; ++slot) {
+                HugePageArena* arena = registry[slot].load(std::memory_order_acquire);
+                if (arena && arena->region.contains(p)) return arena;
+            }
+            return nullptr;
+        }
+
+        inline HugePageRegion& getRegion() { return region; }
+        inline size_t usedBytes() const { return used; }
+        inline size_t getFallbackCount() const { return fallbackCount; }
+        inline void prefault() { region.prefault(); }
+
+        void* allocate(size_t bytes, size_t alignment) {
+            if (alignment <= GRANULE) {
+                size_t sizeClass = classOf(bytes);
+                if (!freeLists[sizeClass] && remoteFrees.load(std::memory_order_relaxed)) {
+                    drainRemoteFrees();
+                }
+                if (FreeBlock* block = freeLists[sizeClass]) {
+                    freeLists[sizeClass] = block->next;
+                    return block;
+                }
+                size_t blockSize = classSize(sizeClass);
+                if (capacity - used >= blockSize) {
+                    void* p = region.begin() + used;
+                    used += blockSize;
+                    return p;
+                }
+            }
+            ++fallbackCount;
+            return ::operator new(bytes, std::align_val_t{alignment});
+        }
+
+        void deallocate(void* p, size_t bytes, size_t alignment) {
+            if (region.contains(p)) {
+                size_t sizeClass = classOf(bytes);
+                freeLists[sizeClass] = new (p) FreeBlock{freeLists[sizeClass]};
+                return;
+            }
+            ::operator delete(p, std::align_val_t{alignment});
+        }
+
+        // Frees a block of this arena from a thread other than its owner.
+        void deallocateRemote(void* p, size_t bytes) {
+            RemoteBlock* block = new (p) RemoteBlock{remoteFrees.load(std::memory_order_relaxed), classOf(bytes)};
+            while (!remoteFrees.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+};
+
+// Stateless allocator over the calling thread's installed HugePageArena, or operator new
+// when none is. Blocks go back to the arena they came from on any thread; the arena must
+// outlive every container that allocated from it.
+template <typename T>
+class HugePageAllocator {
+    public:
+        using value_type = T;
+
+        HugePageAllocator() = default;
+        template <typename U>
+        HugePageAllocator(const HugePageAllocator<U>&) {}
+
+        T* allocate(size_t count) {
+            size_t bytes = count * sizeof(T);
+            if (HugePageArena* arena = HugePageArena::current()) {
+                return static_cast<T*>(arena->allocate(bytes, alignof(T)));
+            }
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+        }
+
+        void deallocate(T* p, size_t count) {
+            HugePageArena* arena = HugePageArena::current();
+            if (arena && arena->getRegion().contains(p)) {
+                arena->deallocate(p, count * sizeof(T), alignof(T));
+                return;
+            }
+            if (HugePageArena* owner = HugePageArena::ownerOf(p)) {
+                owner->deallocateRemote(p, count * sizeof(T));
+                return;
+            }
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        }
+
+        template <typename U>
+        bool operator==(const HugePageAllocator<U>&) const { return true; }
+};
+
+// Default order layout with every book container allocated from the installed arena.
+struct HugePageOrderTraits : DefaultOrderTraits {
+    template <typename U>
+    using Allocator = HugePageAllocator<U>;
+};
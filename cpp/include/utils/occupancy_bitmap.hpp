@@ -0,0 +1,106 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical bitset over [0, size). Layer 0 holds one bit per slot; each bit in layer
+// k + 1 says whether the matching word in layer k is non-zero. Next/previous set-bit
+// searches touch one word per layer, so a 64^3 = 262144-slot ladder resolves in at most
+// three countr_zero/countl_zero steps up and three down (tzcnt/lzcnt with -mbmi -mlzcnt).
+class OccupancyBitmap {
+    private:
+        std::vector<std::vector<uint64_t>> layers;
+        size_t slotCount = 0;
+
+        static constexpr size_t wordIndex(size_t bit) { return bit >> 6; }
+        static constexpr uint64_t bitMask(size_t bit) { return uint64_t{1} << (bit & 63); }
+
+    public:
+        static constexpr size_t npos = SIZE_MAX;
+
+        OccupancyBitmap() = default;
+
+        explicit OccupancyBitmap(size_t size) : slotCount(size) {
+            size_t bits = size;
+            do {
+                size_t words = (bits + 63) / 64;
+                layers.emplace_back(words, 0);
+                bits = words;
+            } while (bits > 1);
+        }
+
+        inline size_t size() const { return slotCount; }
+        inline bool empty() const { return layers.empty() || layers.back().empty() || layers.back()[0] == 0; }
+
+        inline bool test(size_t slot) const {
+            return layers[0][wordIndex(slot)] & bitMask(slot);
+        }
+
+        void set(size_t slot) {
+            for (auto& layer : layers) {
+                uint64_t& word = layer[wordIndex(slot)];
+                bool wasEmpty = word == 0;
+                word |= bitMask(slot);
+                if (!wasEmpty) return;
+                slot = wordIndex(slot);
+            }
+        }
+
+        void clear(size_t slot) {
+            for (auto& layer : layers) {
+                uint64_t& word = layer[wordIndex(slot)];
+                word &= ~bitMask(slot);
+                if (word != 0) return;
+                slot = wordIndex(slot);
+            }
+        }
+
+        // Lowest set slot >= from, or npos.
+        size_t findNext(size_t from) const {
+            if (from >= slotCount) return npos;
+            size_t layer = 0;
+            size_t bit = from;
+            while (true) {
+                const auto& words = layers[layer];
+                if (wordIndex(bit) >= words.size()) return npos;
+                uint64_t word = words[wordIndex(bit)] & (~uint64_t{0} << (bit & 63));
+                if (word != 0) {
+                    bit = (bit & ~size_t{63}) + std::countr_zero(word);
+                    break;
+                }
+                if (++layer == layers.size()) return npos;
+                bit = wordIndex(bit) + 1;
+            }
+            while (layer > 0) {
+                --layer;
+                bit = bit * 64 + std::countr_zero(layers[layer][bit]);
+            }
+            return bit;
+        }
+
+        // Highest set slot <= from, or npos.
+        size_t findPrev(size_t from) const {
+            if (slotCount == 0) return npos;
+            if (from >= slotCount) from = slotCount - 1;
+            size_t layer = 0;
+            size_t bit = from;
+            while (true) {
+                uint64_t word = layers[layer][wordIndex(bit)] & (~uint64_t{0} >> (63 - (bit & 63)));
+                if (word != 0) {
+                    bit = (bit & ~size_t{63}) + 63 - std::countl_zero(word);
+                    break;
+                }
+                if (++layer == layers.size() || wordIndex(bit) == 0) return npos;
+                bit = wordIndex(bit) - 1;
+            }
+            while (layer > 0) {
+                --layer;
+                bit = bit * 64 + 63 - std::countl_zero(layers[layer][bit]);
+            }
+            return bit;
+        }
+
+        inline size_t findFirst() const { return findNext(0); }
+        inline size_t findLast() const { return slotCount ? findPrev(slotCount - 1) : npos; }
+};
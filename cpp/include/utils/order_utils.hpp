@@ -1,6 +1,7 @@
 #pragma once
 #include "models/order.hpp"
 
-inline bool isSelfTrade(const OrderPtr &order1, const OrderPtr &order2) {
+template <typename OrderT>
+inline bool isSelfTrade(const OrderT* order1, const OrderT* order2) {
     return order1->getOwnerID() == order2->getOwnerID();
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock over a trivially copyable value. The writer never waits;
+// readers retry while a write is in progress or if one overlapped their copy. The payload
+// is held as relaxed atomic words so concurrent access is well defined, and the whole cell
+// is cache-line aligned so it shares no line with writer-side state.
+template <typename T>
+class alignas(64) Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    private:
+        static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        std::atomic<uint64_t> sequence{0};
+        std::array<std::atomic<uint64_t>, WORDS> words{};
+
+    public:
+        void store(const T &value) {
+            std::array<uint64_t, WORDS> raw{};
+            std::memcpy(raw.data(), &value, sizeof(T));
+            uint64_t current = sequence.load(std::memory_order_relaxed);
+            sequence.store(current + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORDS; ++i) {
+                words[i].store(raw[i], std::memory_order_relaxed);
+            }
+            sequence.store(current + 2, std::memory_order_release);
+        }
+
+        // Returns false if a write overlapped; out is then unspecified.
+        bool tryLoad(T &out) const {
+            uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) return false;
+            std::array<uint64_t, WORDS> raw;
+            for (size_t i = 0; i < WORDS; ++i) {
+                raw[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != before) return false;
+            std::memcpy(static_cast<void*>(&out), raw.data(), sizeof(T));
+            return true;
+        }
+
+        T load() const {
+            T value;
+            while (!tryLoad(value)) {}
+            return value;
+        }
+
+        // Number of completed stores.
+        inline uint64_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+// Bounded single-producer single-consumer queue. Capacity is rounded up to a power of two.
+// Each side keeps a private copy of the other side's index and rereads the shared one
+// only when that copy says the ring is full (producer) or empty (consumer), so the two
+// index cache lines are touched about once per wrap instead of once per element.
+template <typename T>
+class SpscRing {
+    private:
+        std::vector<T> slots;
+        size_t mask;
+
+        alignas(64) std::atomic<size_t> head{0};    // next slot to pop, written by the consumer
+        size_t cachedTail = 0;
+
+        alignas(64) std::atomic<size_t> tail{0};    // next slot to push, written by the producer
+        size_t cachedHead = 0;
+
+    public:
+        explicit SpscRing(size_t capacity)
+            : slots(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)), mask(slots.size() - 1) {}
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        inline size_t capacity() const { return slots.size(); }
+
+        // Producer side.
+        bool tryPush(const T &value) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            if (position - cachedHead == slots.size()) {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (position - cachedHead == slots.size()) return false;
+            }
+            slots[position & mask] = value;
+            tail.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side.
+        bool tryPop(T &out) {
+            size_t position = head.load(std::memory_order_relaxed);
+            if (position == cachedTail) {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (position == cachedTail) return false;
+            }
+            out = slots[position & mask];
+            head.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side: hands up to maxCount queued elements to fn in order and releases
+        // their slots in one store. Returns the number consumed.
+        template <typename Fn>
+        size_t drain(Fn &&fn, size_t maxCount = SIZE_MAX) {
+            size_t position = head.load(std::memory_order_relaxed);
+            cachedTail = tail.load(std::memory_order_acquire);
+            size_t count = std::min(cachedTail - position, maxCount);
+            for (size_t i = 0; i < count; ++i) {
+                fn(slots[(position + i) & mask]);
+            }
+            if (count) head.store(position + count, std::memory_order_release);
+            return count;
+        }
+
+        bool empty() const {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+};
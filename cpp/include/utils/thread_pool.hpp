@@ -0,0 +1,78 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of workers that split a batch of indexed tasks. parallelFor blocks the
+// caller until every index has run; tasks are claimed in index order.
+class ThreadPool {
+    private:
+        std::mutex mutex;
+        std::condition_variable wakeWorkers;
+        std::condition_variable batchDone;
+        std::function<void(size_t)> task;
+        size_t taskCount = 0;
+        size_t nextTask = 0;
+        size_t finishedTasks = 0;
+        uint64_t batch = 0;
+        bool stopping = false;
+        std::vector<std::jthread> workers;  // last member: joined before the state above is destroyed
+
+        void workerLoop() {
+            uint64_t seenBatch = 0;
+            std::unique_lock lock(mutex);
+            while (true) {
+                wakeWorkers.wait(lock, [&] { return stopping || batch != seenBatch; });
+                if (stopping) return;
+                seenBatch = batch;
+                while (nextTask < taskCount) {
+                    size_t index = nextTask++;
+                    lock.unlock();
+                    task(index);
+                    lock.lock();
+                    if (++finishedTasks == taskCount) {
+                        batchDone.notify_all();
+                    }
+                }
+            }
+        }
+
+    public:
+        explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency()) {
+            if (threadCount == 0) threadCount = 1;
+            workers.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; ++i) {
+                workers.emplace_back([this] { workerLoop(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            wakeWorkers.notify_all();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        inline size_t size() const { return workers.size(); }
+
+        void parallelFor(size_t count, std::function<void(size_t)> fn) {
+            if (count == 0) return;
+            std::unique_lock lock(mutex);
+            task = std::move(fn);
+            taskCount = count;
+            nextTask = 0;
+            finishedTasks = 0;
+            ++batch;
+            wakeWorkers.notify_all();
+            batchDone.wait(lock, [&] { return finishedTasks == taskCount; });
+            task = nullptr;
+        }
+};
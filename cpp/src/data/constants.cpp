@@ -1,2 +1 @@
-float TICK_SIZE = 0.01f;
 float TIME_INTERVAL = 1.0f;
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "sim/differential_harness.hpp"
+
+// Usage: differential_soak [events] [seed] [rounds]
+// Each round runs a fresh seed (seed, seed + 1, ...) through the map and ladder books.
+int main(int argc, char** argv) {
+    uint64_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+    uint64_t rounds = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+
+    InstrumentSpec instrument{TickLadder(), PriceBand{1, 100000}};
+    CancelRestingSTP stpPolicy;
+
+    for (uint64_t round = 0; round < rounds; ++round) {
+        DifferentialHarness<LimitOrderBook, LadderOrderBook> harness(&instrument, &stpPolicy, seed + round, 1 << 20);
+        auto start = std::chrono::steady_clock::now();
+        DifferentialReport report = harness.run(events, 50000);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("seed %llu: %llu events in %.2fs (%.2fM events/s)\n",
+            static_cast<unsigned long long>(seed + round),
+            static_cast<unsigned long long>(report.eventsRun),
+            seconds, report.eventsRun / seconds / 1e6);
+
+        if (report.divergence) {
+            std::printf("DIVERGED at event %zu: %s\nminimal reproducer (%zu commands):\n",
+                report.divergence->eventIndex, report.divergence->description.c_str(), report.minimalFailure.size());
+            for (const HarnessCommand &command : report.minimalFailure) {
+                std::printf("  %s #%u owner %u %s %s px %lld qty %d\n",
+                    command.kind == HarnessCommand::Kind::Submit ? "submit" : "cancel",
+                    command.orderID, command.ownerID,
+                    command.side == Side::Buy ? "buy" : "sell",
+                    command.type == OrderType::Limit ? "limit" : "market",
+                    static_cast<long long>(command.price), command.qty);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "models/engine_host.hpp"
+
+// Usage: engine_host [orders] [core] [spin|yield|sleep] [warmup orders]
+// Feeds a synthetic limit/market flow through an EngineHost from the main thread and
+// reports end-to-end throughput. core -1 leaves the matching thread unpinned.
+namespace {
+struct CountingListener {
+    uint64_t fills = 0;
+    uint64_t rested = 0;
+
+    void onSubmit(const OrderPtr &, const MatchOutcome &outcome, std::span<const Fill> lastFills) {
+        fills += lastFills.size();
+        rested += outcome && outcome->resting;
+    }
+
+    void onCancel(const OrderPtr &, RejectionReason) {}
+};
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5'000'000;
+    EngineHostConfig config;
+    config.core = argc > 2 ? std::atoi(argv[2]) : -1;
+    if (argc > 3 && std::strcmp(argv[3], "yield") == 0) config.idleWait = IdleWait::SpinThenYield;
+    if (argc > 3 && std::strcmp(argv[3], "sleep") == 0) config.idleWait = IdleWait::SpinThenSleep;
+    if (argc > 4) config.warmupOrders = static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10));
+
+    std::vector<Order> orders;
+    orders.reserve(count);
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> offset(-5, 30);
+    std::uniform_int_distribution<int> qty(1, 100);
+    for (size_t i = 0; i < count; ++i) {
+        Side side = i % 2 ? Side::Buy : Side::Sell;
+        OrderType type = i % 20 == 0 ? OrderType::Market : OrderType::Limit;
+        PriceTicks price = type == OrderType::Market ? 0 : (side == Side::Buy ? 10000 - offset(rng) : 10000 + offset(rng));
+        orders.emplace_back(static_cast<OrderID>(i + 1), static_cast<OwnerID>(i % 1000), price, qty(rng), side, type, i);
+    }
+
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    EngineHost<LimitOrderBook, CountingListener> host(&book, &stpPolicy, config);
+    auto warmStart = std::chrono::steady_clock::now();
+    host.start();
+    host.waitUntilReady();
+    auto start = std::chrono::steady_clock::now();
+    for (Order& order : orders) host.submit(&order);
+    host.stop();
+    auto end = std::chrono::steady_clock::now();
+
+    double warmSeconds = std::chrono::duration<double>(start - warmStart).count();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    const EngineHostStats& stats = host.getStats();
+    std::printf("pinned %s, warm-up %llu orders in %.3fs\n",
+        stats.pinned ? "yes" : "no", static_cast<unsigned long long>(stats.warmupOrders), warmSeconds);
+    std::printf("%zu orders in %.3fs (%.2fM orders/s), %llu fills, %llu rested, %llu empty polls, %llu backoffs\n",
+        count, seconds, count / seconds / 1e6,
+        static_cast<unsigned long long>(host.getListener().fills),
+        static_cast<unsigned long long>(host.getListener().rested),
+        static_cast<unsigned long long>(stats.emptyPolls),
+        static_cast<unsigned long long>(stats.backoffs));
+}
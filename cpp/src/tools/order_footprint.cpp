@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include "models/order_book.hpp"
+
+// Usage: order_footprint [orders] [levels]
+// Rests the given number of orders across the given number of price levels on each side
+// and reports heap bytes per resting order: the order itself plus the book's level,
+// queue and ID-index nodes.
+namespace {
+size_t allocatedBytes = 0;
+}
+
+void* operator new(size_t size) {
+    allocatedBytes += size;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    allocatedBytes += size;
+    if (void* p = std::aligned_alloc(static_cast<size_t>(alignment), (size + static_cast<size_t>(alignment) - 1) & ~(static_cast<size_t>(alignment) - 1))) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+template <typename Traits>
+void measure(const char* name, size_t orderCount, size_t levelCount) {
+    using BookOrder = BasicOrder<Traits>;
+    size_t before = allocatedBytes;
+    {
+        std::deque<BookOrder> orders;
+        LimitOrderBookFor<Traits> book;
+        size_t afterOrders = 0;
+        for (size_t i = 0; i < orderCount; ++i) {
+            Side side = i % 2 ? Side::Buy : Side::Sell;
+            auto offset = static_cast<typename BookOrder::Price>(1 + (i / 2) % levelCount);
+            auto price = static_cast<typename BookOrder::Price>(side == Side::Buy ? 10000 - offset : 10000 + offset);
+            orders.emplace_back(static_cast<typename BookOrder::ID>(i + 1), 1, price, 10, side, OrderType::Limit, i);
+        }
+        afterOrders = allocatedBytes;
+        for (auto& order : orders) book.addOrder(&order);
+        size_t orderBytes = afterOrders - before;
+        size_t bookBytes = allocatedBytes - afterOrders;
+        std::printf("%-8s sizeof(order) %2zu  order storage %5.1f B/order  book %5.1f B/order  total %5.1f B/order\n",
+            name, sizeof(BookOrder),
+            static_cast<double>(orderBytes) / orderCount,
+            static_cast<double>(bookBytes) / orderCount,
+            static_cast<double>(orderBytes + bookBytes) / orderCount);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t orders = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    size_t levels = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+    measure<DefaultOrderTraits>("default", orders, levels);
+    measure<CompactOrderTraits>("compact", orders, levels);
+    measure<WideIDOrderTraits>("wide-id", orders, levels);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "analytics/microstructure.hpp"
+#include "models/matching_engine.hpp"
+
+class MicrostructureTest : public ::testing::Test {
+    protected:
+        LimitOrderBook book;
+        CancelBothSTP stpPolicy;
+        MatchingEngine engine{&stpPolicy, &book};
+        MicrostructureAnalytics<LimitOrderBook> analytics{&book, MicrostructureConfig{2, 100}};
+        std::deque<Order> orders;
+
+        void submit(OrderID id, PriceTicks price, Quantity qty, Side side, Timestamp time, OrderType type = OrderType::Limit) {
+            engine.matchOrder(&orders.emplace_back(id, id, price, qty, side, type, time));
+            analytics.onEvent(engine.getLastFills(), time);
+        }
+};
+
+TEST_F(MicrostructureTest, TracksVolumeVwapAndEffectiveSpread) {
+    submit(1, 100, 10, Side::Sell, 1);
+    submit(2, 101, 10, Side::Sell, 2);
+    submit(3, 98, 10, Side::Buy, 3);
+    submit(4, 0, 15, Side::Buy, 10, OrderType::Market);
+
+    const MicrostructureSnapshot& s = analytics.snapshot();
+    EXPECT_EQ(s.events, 4u);
+    EXPECT_EQ(s.trades, 2u);
+    EXPECT_EQ(s.volume, 15);
+    EXPECT_EQ(s.buyVolume, 15);
+    EXPECT_EQ(s.sellVolume(), 0);
+    EXPECT_DOUBLE_EQ(s.vwap(), (10 * 100 + 5 * 101) / 15.0);
+    // Mid before the fill is 99: 2 * (100 - 99) on 10 and 2 * (101 - 99) on 5.
+    EXPECT_DOUBLE_EQ(s.effectiveSpread(), (10 * 2 + 5 * 4) / 15.0);
+}
+
+TEST_F(MicrostructureTest, RealizedSpreadUsesFirstMidAfterHorizon) {
+    submit(1, 100, 10, Side::Sell, 1);
+    submit(2, 98, 10, Side::Buy, 2);
+    submit(3, 0, 4, Side::Buy, 10, OrderType::Market);
+    submit(4, 99, 7, Side::Buy, 50);
+    EXPECT_EQ(analytics.pendingRealizedCount(), 1u);
+    EXPECT_EQ(analytics.snapshot().realizedSpreadVolume, 0);
+
+    submit(5, 120, 1, Side::Sell, 200);
+
+    EXPECT_EQ(analytics.pendingRealizedCount(), 0u);
+    // Mid (99 + 100) / 2 at t = 200: 2 * (100 - 99.5) = 1.
+    EXPECT_DOUBLE_EQ(analytics.snapshot().realizedSpread(), 1.0);
+}
+
+TEST_F(MicrostructureTest, OrderFlowImbalanceFollowsBestQuotes) {
+    submit(1, 100, 10, Side::Sell, 1);
+    EXPECT_EQ(analytics.snapshot().orderFlowImbalance, -10);
+    submit(2, 101, 10, Side::Sell, 2);
+    EXPECT_EQ(analytics.snapshot().orderFlowImbalance, -10);
+    submit(3, 98, 10, Side::Buy, 3);
+    EXPECT_EQ(analytics.snapshot().orderFlowImbalance, 0);
+    submit(4, 0, 5, Side::Buy, 4, OrderType::Market);
+    EXPECT_EQ(analytics.snapshot().orderFlowImbalance, 5);
+    submit(5, 99, 7, Side::Buy, 5);
+    EXPECT_EQ(analytics.snapshot().orderFlowImbalance, 12);
+    submit(6, 0, 5, Side::Buy, 6, OrderType::Market);
+    // Best ask retreats from 100 to 101: the old 5 are added back, the new 10 not taken off.
+    EXPECT_EQ(analytics.snapshot().orderFlowImbalance, 17);
+}
+
+TEST_F(MicrostructureTest, DepthImbalanceOverTopLevelsAndFeed) {
+    Seqlock<MicrostructureSnapshot> feed;
+    analytics.setFeed(&feed);
+    submit(1, 100, 5, Side::Sell, 1);
+    submit(2, 101, 10, Side::Sell, 2);
+    submit(3, 102, 50, Side::Sell, 3);
+    submit(4, 99, 7, Side::Buy, 4);
+    submit(5, 98, 10, Side::Buy, 5);
+
+    MicrostructureSnapshot s = feed.load();
+    EXPECT_EQ(s.bidDepth, 17);
+    EXPECT_EQ(s.askDepth, 15);
+    EXPECT_DOUBLE_EQ(s.depthImbalance(), 2.0 / 32.0);
+    EXPECT_EQ(feed.version(), 5u);
+
+    analytics.reset();
+    EXPECT_EQ(analytics.snapshot().events, 0u);
+    EXPECT_EQ(analytics.snapshot().bidDepth, 17);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "analytics/ohlcv_bars.hpp"
+#include "models/matching_engine.hpp"
+
+TEST(BarRingTest, OverwritesOldestWhenFull) {
+    BarRing ring(2);
+    for (Timestamp start = 0; start < 3; ++start) {
+        Bar bar;
+        bar.start = start;
+        ring.push(bar);
+    }
+
+    EXPECT_EQ(ring.size(), 2u);
+    EXPECT_EQ(ring[0].start, 1u);
+    EXPECT_EQ(ring.back().start, 2u);
+    EXPECT_EQ(ring.totalEmitted(), 3u);
+}
+
+TEST(BarAggregatorTest, RejectsIntervalsThatAreNotMultiples) {
+    EXPECT_FALSE(BarAggregator::create({}).has_value());
+    EXPECT_FALSE(BarAggregator::create({{10, 4}, {25, 4}}).has_value());
+    EXPECT_FALSE(BarAggregator::create({{10, 0}}).has_value());
+    EXPECT_TRUE(BarAggregator::create({{10, 4}, {30, 4}}).has_value());
+}
+
+TEST(BarAggregatorTest, BuildsSecondBarsFromFills) {
+    BarAggregator bars = BarAggregator::standard(1000, 16);
+    bars.onFill(100, 5, 10);
+    bars.onFill(103, 1, 400);
+    bars.onFill(99, 2, 999);
+    EXPECT_TRUE(bars.getBars(0).empty());
+    bars.onFill(101, 3, 2500);
+
+    ASSERT_EQ(bars.getBars(0).size(), 1u);
+    const Bar& first = bars.getBars(0)[0];
+    EXPECT_EQ(first.start, 0u);
+    EXPECT_EQ(first.open, 100);
+    EXPECT_EQ(first.high, 103);
+    EXPECT_EQ(first.low, 99);
+    EXPECT_EQ(first.close, 99);
+    EXPECT_EQ(first.volume, 8);
+    EXPECT_EQ(first.trades, 3u);
+    EXPECT_DOUBLE_EQ(first.vwap(), (500 + 103 + 198) / 8.0);
+    ASSERT_TRUE(bars.getOpenBar(0).has_value());
+    EXPECT_EQ(bars.getOpenBar(0)->start, 2000u);
+}
+
+TEST(BarAggregatorTest, RollsClosedBarsUpWithoutRereadingTrades) {
+    BarAggregator bars = BarAggregator::standard(1000, 16);
+    bars.onFill(100, 1, 500);           // minute 0
+    bars.onFill(110, 1, 30'000);        // minute 0
+    bars.onFill(90, 1, 59'999);         // minute 0
+    bars.onFill(95, 4, 61'000);         // minute 1
+    bars.advanceTo(3'600'000);
+
+    const BarRing& seconds = bars.getBars(0);
+    const BarRing& minutes = bars.getBars(1);
+    ASSERT_EQ(seconds.size(), 4u);
+    ASSERT_EQ(minutes.size(), 2u);
+    EXPECT_EQ(minutes[0].start, 0u);
+    EXPECT_EQ(minutes[0].open, 100);
+    EXPECT_EQ(minutes[0].high, 110);
+    EXPECT_EQ(minutes[0].low, 90);
+    EXPECT_EQ(minutes[0].close, 90);
+    EXPECT_EQ(minutes[0].trades, 3u);
+    EXPECT_EQ(minutes[1].start, 60'000u);
+    EXPECT_EQ(minutes[1].volume, 4);
+
+    ASSERT_EQ(bars.getBars(2).size(), 1u);
+    EXPECT_EQ(bars.getBars(2)[0].volume, 7);
+    ASSERT_EQ(bars.getBars(3).size(), 1u);
+    EXPECT_EQ(bars.getBars(3)[0].open, 100);
+    EXPECT_EQ(bars.getBars(3)[0].close, 95);
+    EXPECT_FALSE(bars.getOpenBar(3).has_value());
+}
+
+TEST(BarAggregatorTest, ConsumesEngineFills) {
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine(&stpPolicy, &book);
+    BarAggregator bars = *BarAggregator::create({{100, 8}, {1000, 8}});
+    std::deque<Order> orders;
+    orders.emplace_back(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1);
+    orders.emplace_back(2, 2, 101, 10, Side::Sell, OrderType::Limit, 2);
+    orders.emplace_back(3, 3, 0, 15, Side::Buy, OrderType::Market, 50);
+    for (auto& order : orders) {
+        engine.matchOrder(&order);
+        bars.onFills(engine.getLastFills());
+    }
+    bars.advanceTo(1000);
+
+    ASSERT_EQ(bars.getBars(1).size(), 1u);
+    EXPECT_EQ(bars.getBars(1)[0].open, 100);
+    EXPECT_EQ(bars.getBars(1)[0].close, 101);
+    EXPECT_EQ(bars.getBars(1)[0].volume, 15);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "models/matching_engine.hpp"
+#include "order_store.hpp"
+
+TEST(AuctionUncrossTest, NoCrossNoEquilibrium) {
+    std::vector<DepthPoint> bids{{99, 10}};
+    std::vector<DepthPoint> asks{{100, 10}};
+
+    EXPECT_EQ(AuctionUncross::findEquilibrium(bids, asks), std::nullopt);
+    EXPECT_EQ(AuctionUncross::findEquilibrium({}, asks), std::nullopt);
+}
+
+TEST(AuctionUncrossTest, MaximisesExecutableVolume) {
+    std::vector<DepthPoint> bids{{103, 10}, {102, 20}, {100, 30}};
+    std::vector<DepthPoint> asks{{99, 15}, {101, 15}, {102, 30}};
+
+    auto equilibrium = AuctionUncross::findEquilibrium(bids, asks);
+
+    // demand/supply: 100 -> 60/15, 101 -> 30/30, 102 -> 30/60
+    ASSERT_TRUE(equilibrium.has_value());
+    EXPECT_EQ(equilibrium->price, 101);
+    EXPECT_EQ(equilibrium->volume, 30);
+    EXPECT_EQ(equilibrium->imbalance, 0);
+}
+
+TEST(AuctionUncrossTest, MinimisesImbalanceOnVolumeTie) {
+    std::vector<DepthPoint> bids{{105, 10}, {101, 5}};
+    std::vector<DepthPoint> asks{{100, 10}, {104, 10}};
+
+    auto equilibrium = AuctionUncross::findEquilibrium(bids, asks);
+
+    // 100/101 -> demand 15 vs supply 10, 104/105 -> demand 10 vs supply 20; 102/103 are not
+    // level prices. Volume 10 everywhere, smallest |imbalance| is 5 at 100 and 101 with buy
+    // pressure, so the higher of the two wins.
+    ASSERT_TRUE(equilibrium.has_value());
+    EXPECT_EQ(equilibrium->volume, 10);
+    EXPECT_EQ(equilibrium->imbalance, 5);
+    EXPECT_EQ(equilibrium->price, 101);
+}
+
+TEST(AuctionUncrossTest, SellPressureTakesLowestPrice) {
+    std::vector<DepthPoint> bids{{105, 10}};
+    std::vector<DepthPoint> asks{{100, 12}, {103, 3}};
+
+    auto equilibrium = AuctionUncross::findEquilibrium(bids, asks);
+
+    ASSERT_TRUE(equilibrium.has_value());
+    EXPECT_EQ(equilibrium->volume, 10);
+    EXPECT_EQ(equilibrium->imbalance, -2);
+    EXPECT_EQ(equilibrium->price, 100);
+}
+
+class AuctionEngineTest : public ::testing::Test {
+protected:
+    LimitOrderBook orderBook;
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine{&stpPolicy, &orderBook};
+    OrderStore orders;
+
+    OrderPtr submit(OwnerID owner, PriceTicks price, Quantity qty, Side side, OrderType type = OrderType::Limit) {
+        orders.add(orders.size() + 1, owner, price, qty, side, type, 1000 + orders.size());
+        engine.matchOrder(orders.back());
+        return orders.back();
+    }
+
+    void SetUp() override {
+        engine.setTradingPhase(TradingPhase::Auction);
+    }
+};
+
+TEST_F(AuctionEngineTest, OrdersAccumulateWithoutMatching) {
+    OrderPtr buy = submit(1, 105, 10, Side::Buy);
+    OrderPtr sell = submit(2, 100, 10, Side::Sell);
+    OrderPtr market = submit(3, 0, 10, Side::Buy, OrderType::Market);
+
+    EXPECT_EQ(buy->getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(sell->getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(market->getStatus(), OrderStatus::Cancelled);
+    EXPECT_EQ(orderBook.getBestBid(), 105);
+    EXPECT_EQ(orderBook.getBestAsk(), 100);
+    EXPECT_TRUE(engine.getLastFills().empty());
+}
+
+TEST_F(AuctionEngineTest, UncrossExecutesAtSinglePriceInPriority) {
+    OrderPtr bid1 = submit(1, 103, 10, Side::Buy);
+    OrderPtr bid2 = submit(2, 102, 20, Side::Buy);
+    OrderPtr bid3 = submit(3, 100, 30, Side::Buy);
+    OrderPtr ask1 = submit(4, 99, 15, Side::Sell);
+    OrderPtr ask2 = submit(5, 101, 15, Side::Sell);
+    OrderPtr ask3 = submit(6, 102, 30, Side::Sell);
+
+    auto result = engine.uncross(5000);
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->price, 101);
+    EXPECT_EQ(result->volume, 30);
+    EXPECT_EQ(bid1->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(bid2->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(bid3->getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(ask1->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(ask2->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(ask3->getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(orderBook.getBestBid(), 100);
+    EXPECT_EQ(orderBook.getBestAsk(), 102);
+
+    Quantity total = 0;
+    for (const Fill &fill : engine.getLastFills()) {
+        EXPECT_EQ(fill.price, 101);
+        EXPECT_EQ(fill.timestamp, 5000u);
+        EXPECT_EQ(fill.takerSide, Side::Buy);
+        total += fill.qty;
+    }
+    EXPECT_EQ(total, 30);
+    EXPECT_EQ(engine.getLastFills().size(), 3u);
+}
+
+TEST_F(AuctionEngineTest, PartialFillAtMarginalOrder) {
+    OrderPtr bid = submit(1, 101, 25, Side::Buy);
+    OrderPtr ask1 = submit(2, 100, 10, Side::Sell);
+    OrderPtr ask2 = submit(3, 100, 5, Side::Sell);
+
+    auto result = engine.uncross(5000);
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->volume, 15);
+    EXPECT_EQ(bid->getStatus(), OrderStatus::PartiallyExecuted);
+    EXPECT_EQ(bid->getQty(), 10);
+    EXPECT_EQ(ask1->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(ask2->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(orderBook.getBestAsk(), std::nullopt);
+    EXPECT_EQ(orderBook.estimateImpact(Side::Sell, 100).filledQty, 10);
+}
+
+TEST_F(AuctionEngineTest, UncrossOnUncrossedBookDoesNothing) {
+    submit(1, 99, 10, Side::Buy);
+    submit(2, 100, 10, Side::Sell);
+
+    EXPECT_EQ(engine.uncross(5000), std::nullopt);
+    EXPECT_TRUE(engine.getLastFills().empty());
+}
+
+TEST_F(AuctionEngineTest, ContinuousMatchingAfterAuction) {
+    submit(1, 101, 10, Side::Buy);
+    submit(2, 100, 10, Side::Sell);
+    engine.uncross(5000);
+    engine.setTradingPhase(TradingPhase::Continuous);
+
+    OrderPtr ask = submit(3, 102, 5, Side::Sell);
+    OrderPtr buy = submit(4, 102, 5, Side::Buy);
+
+    EXPECT_EQ(ask->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(buy->getStatus(), OrderStatus::Executed);
+    ASSERT_EQ(engine.getLastFills().size(), 1u);
+    EXPECT_EQ(engine.getLastFills()[0].takerOrderID, 4u);
+    EXPECT_EQ(engine.getLastFills()[0].makerOrderID, 3u);
+    EXPECT_EQ(engine.getLastFills()[0].price, 102);
+}
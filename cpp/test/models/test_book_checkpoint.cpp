@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "models/book_checkpoint.hpp"
+#include "order_store.hpp"
+
+class BookCheckpointTest : public ::testing::Test {
+protected:
+    LimitOrderBook book;
+    OrderStore orders;
+
+    OrderPtr rest(OrderID id, OwnerID owner, PriceTicks price, Quantity qty, Side side) {
+        orders.add(id, owner, price, qty, side, OrderType::Limit, 1000 + id);
+        book.addOrder(orders.back());
+        return orders.back();
+    }
+};
+
+TEST_F(BookCheckpointTest, RoundTripPreservesLevelsFifoAndStatus) {
+    rest(1, 1, 100, 10, Side::Buy);
+    rest(2, 2, 100, 20, Side::Buy);
+    rest(3, 3, 105, 5, Side::Buy);
+    OrderPtr partial = rest(4, 4, 110, 7, Side::Sell);
+    rest(5, 5, 110, 8, Side::Sell);
+    rest(6, 6, 120, 9, Side::Sell);
+    partial->setStatus(OrderStatus::PartiallyExecuted);
+
+    std::vector<std::byte> data = BookCheckpoint::save(book, 42);
+
+    LimitOrderBook restored;
+    std::vector<Order> storage;
+    uint64_t sequence = 0;
+    ASSERT_EQ(BookCheckpoint::load(data, restored, storage, &sequence), CheckpointError::None);
+
+    EXPECT_EQ(sequence, 42u);
+    EXPECT_EQ(storage.size(), 6u);
+    EXPECT_EQ(restored.getBestBid(), 105);
+    EXPECT_EQ(restored.getBestAsk(), 110);
+    for (OrderID id = 1; id <= 6; ++id) {
+        EXPECT_TRUE(restored.doesOrderExist(id));
+    }
+
+    EXPECT_EQ(restored.getMatchedOrder(Side::Buy)->getOrderID(), 4u);
+    EXPECT_EQ(restored.getMatchedOrder(Side::Buy)->getStatus(), OrderStatus::PartiallyExecuted);
+    restored.popFront(Side::Buy);
+    EXPECT_EQ(restored.getMatchedOrder(Side::Buy)->getOrderID(), 5u);
+
+    EXPECT_EQ(restored.getMatchedOrder(Side::Sell)->getOrderID(), 3u);
+    restored.popFront(Side::Sell);
+    EXPECT_EQ(restored.getMatchedOrder(Side::Sell)->getOrderID(), 1u);
+    EXPECT_EQ(restored.getMatchedOrder(Side::Sell)->getQty(), 10);
+    restored.popFront(Side::Sell);
+    EXPECT_EQ(restored.getMatchedOrder(Side::Sell)->getOrderID(), 2u);
+
+    EXPECT_EQ(restored.removeOrder(6), RejectionReason::None);
+    EXPECT_FALSE(restored.doesOrderExist(6));
+}
+
+TEST_F(BookCheckpointTest, EmptyBookRoundTrip) {
+    std::vector<std::byte> data = BookCheckpoint::save(book);
+
+    LimitOrderBook restored;
+    std::vector<Order> storage;
+    EXPECT_EQ(BookCheckpoint::load(data, restored, storage), CheckpointError::None);
+    EXPECT_EQ(restored.getBestBid(), std::nullopt);
+    EXPECT_EQ(restored.getBestAsk(), std::nullopt);
+}
+
+TEST_F(BookCheckpointTest, LargeBookRoundTrip) {
+    for (OrderID id = 1; id <= 100000; ++id) {
+        Side side = id % 2 ? Side::Buy : Side::Sell;
+        PriceTicks price = side == Side::Buy ? 1000 - id % 500 : 1001 + id % 500;
+        rest(id, id % 97, price, 1 + id % 13, side);
+    }
+
+    std::vector<std::byte> data = BookCheckpoint::save(book);
+    LimitOrderBook restored;
+    std::vector<Order> storage;
+    ASSERT_EQ(BookCheckpoint::load(data, restored, storage), CheckpointError::None);
+
+    EXPECT_EQ(storage.size(), 100000u);
+    EXPECT_EQ(BookCheckpoint::save(restored), data);
+}
+
+TEST_F(BookCheckpointTest, RejectsBadMagicAndTruncatedInput) {
+    rest(1, 1, 100, 10, Side::Buy);
+    std::vector<std::byte> data = BookCheckpoint::save(book);
+
+    LimitOrderBook restored;
+    std::vector<Order> storage;
+    std::vector<std::byte> truncated(data.begin(), data.end() - 1);
+    EXPECT_EQ(BookCheckpoint::load(truncated, restored, storage), CheckpointError::Truncated);
+    EXPECT_EQ(BookCheckpoint::load(std::span(data).first(8), restored, storage), CheckpointError::Truncated);
+
+    data[0] = std::byte{0};
+    EXPECT_EQ(BookCheckpoint::load(data, restored, storage), CheckpointError::BadMagic);
+    EXPECT_TRUE(storage.empty());
+}
+
+TEST_F(BookCheckpointTest, RejectsNonEmptyTarget) {
+    rest(1, 1, 100, 10, Side::Buy);
+    std::vector<std::byte> data = BookCheckpoint::save(book);
+
+    std::vector<Order> storage;
+    EXPECT_EQ(BookCheckpoint::load(data, book, storage), CheckpointError::TargetNotEmpty);
+}
+
+TEST_F(BookCheckpointTest, InvalidRecordLeavesTargetEmpty) {
+    rest(1, 1, 100, 10, Side::Buy);
+    rest(2, 2, 105, 10, Side::Buy);
+    std::vector<std::byte> data = BookCheckpoint::save(book);
+
+    CheckpointRecord record;
+    std::memcpy(&record, data.data() + sizeof(CheckpointHeader), sizeof(record));
+    record.priceTicks = 90;  // best bid now below the next level
+    std::memcpy(data.data() + sizeof(CheckpointHeader), &record, sizeof(record));
+
+    LimitOrderBook restored;
+    std::vector<Order> storage;
+    EXPECT_EQ(BookCheckpoint::load(data, restored, storage), CheckpointError::InvalidRecord);
+    EXPECT_FALSE(restored.doesOrderExist(1));
+    EXPECT_FALSE(restored.doesOrderExist(2));
+    EXPECT_EQ(restored.getBestBid(), std::nullopt);
+    EXPECT_TRUE(storage.empty());
+}
+
+TEST(BookCheckpointTraitsTest, RoundTripsWideIDBookAndNarrowsIntoCompactBook) {
+    using WideIDOrder = BasicOrder<WideIDOrderTraits>;
+    using CompactOrder = BasicOrder<CompactOrderTraits>;
+    LimitOrderBookFor<WideIDOrderTraits> wide;
+    std::deque<WideIDOrder> orders;
+    uint64_t bigID = (uint64_t{1} << 40) + 7;
+    wide.addOrder(&orders.emplace_back(bigID, 1, 100, 10, Side::Buy, OrderType::Limit, 1));
+    wide.addOrder(&orders.emplace_back(2, 2, 105, 4, Side::Sell, OrderType::Limit, 2));
+
+    std::vector<std::byte> data = BookCheckpoint::save(wide);
+
+    LimitOrderBookFor<WideIDOrderTraits> restored;
+    std::vector<WideIDOrder> storage;
+    ASSERT_EQ(BookCheckpoint::load(data, restored, storage), CheckpointError::None);
+    EXPECT_TRUE(restored.doesOrderExist(bigID));
+    EXPECT_EQ(restored.getBestAsk(), 105);
+
+    // The 40-bit ID does not fit a compact order.
+    LimitOrderBookFor<CompactOrderTraits> compact;
+    std::vector<CompactOrder> compactStorage;
+    EXPECT_EQ(BookCheckpoint::load(data, compact, compactStorage), CheckpointError::InvalidRecord);
+
+    LimitOrderBookFor<CompactOrderTraits> source;
+    std::deque<CompactOrder> compactOrders;
+    source.addOrder(&compactOrders.emplace_back(3, 3, 200, 6, Side::Sell, OrderType::Limit, 3));
+    data = BookCheckpoint::save(source);
+    ASSERT_EQ(BookCheckpoint::load(data, compact, compactStorage), CheckpointError::None);
+    EXPECT_EQ(compact.getBestAsk(), 200);
+    EXPECT_EQ(compactStorage[0].getQty(), 6);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "models/depth_snapshot.hpp"
+#include "models/matching_engine.hpp"
+#include "order_store.hpp"
+
+class DepthSnapshotTest : public ::testing::Test {
+protected:
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine{&stpPolicy, &book};
+    OrderStore orders;
+
+    OrderPtr make(OrderID id, PriceTicks price, Quantity qty, Side side, OrderType type = OrderType::Limit) {
+        orders.add(id, id, price, qty, side, type, id);
+        return orders.back();
+    }
+
+    using Level = std::tuple<PriceTicks, int64_t, uint32_t>;
+
+    static std::vector<Level> levelsOf(const DepthSnapshot &snapshot, Side side) {
+        std::vector<Level> levels;
+        snapshot.forEachLevel(side, [&](PriceTicks price, int64_t qty, uint32_t count) {
+            levels.emplace_back(price, qty, count);
+            return true;
+        });
+        return levels;
+    }
+
+    template <typename Levels>
+    static std::vector<Level> levelsOf(const Levels &bookLevels) {
+        std::vector<Level> levels;
+        bookLevels.forEachLevel([&](PriceTicks price, const PriceLevel &level) {
+            levels.emplace_back(price, level.totalQty, static_cast<uint32_t>(level.orders.size()));
+            return true;
+        });
+        return levels;
+    }
+};
+
+TEST_F(DepthSnapshotTest, InitialSnapshotCoversExistingBook) {
+    book.addOrder(make(1, 99, 10, Side::Buy));
+    book.addOrder(make(2, 99, 5, Side::Buy));
+    book.addOrder(make(3, 20, 1, Side::Buy));
+    book.addOrder(make(4, 101, 7, Side::Sell));
+    DepthPublisher<LimitOrderBook> publisher(&book);
+    uint32_t reader = *publisher.registerReader();
+
+    auto snapshot = publisher.read(reader);
+
+    EXPECT_EQ(snapshot->getVersion(), 1u);
+    EXPECT_EQ(levelsOf(*snapshot, Side::Buy), (std::vector<Level>{{99, 15, 2}, {20, 1, 1}}));
+    EXPECT_EQ(levelsOf(*snapshot, Side::Sell), (std::vector<Level>{{101, 7, 1}}));
+    EXPECT_EQ(snapshot->levelCount(Side::Buy), 2u);
+}
+
+TEST_F(DepthSnapshotTest, PublishAppliesOnlyLoggedChanges) {
+    DepthPublisher<LimitOrderBook> publisher(&book);
+    uint32_t reader = *publisher.registerReader();
+    engine.matchOrder(make(1, 99, 10, Side::Buy));
+    engine.matchOrder(make(2, 100, 10, Side::Sell));
+    engine.matchOrder(make(3, 0, 4, Side::Sell, OrderType::Market));
+    book.removeOrder(2);
+
+    EXPECT_EQ(publisher.pendingChanges(), 4u);
+    publisher.publish();
+    EXPECT_EQ(publisher.pendingChanges(), 0u);
+
+    auto snapshot = publisher.read(reader);
+    EXPECT_EQ(levelsOf(*snapshot, Side::Buy), (std::vector<Level>{{99, 6, 1}}));
+    EXPECT_TRUE(levelsOf(*snapshot, Side::Sell).empty());
+}
+
+TEST_F(DepthSnapshotTest, HeldSnapshotStaysUnchangedAcrossPublishes) {
+    DepthPublisher<LimitOrderBook> publisher(&book);
+    uint32_t reader = *publisher.registerReader();
+    engine.matchOrder(make(1, 99, 10, Side::Buy));
+    publisher.publish();
+
+    {
+        auto held = publisher.read(reader);
+        engine.matchOrder(make(2, 0, 10, Side::Sell, OrderType::Market));
+        publisher.publish();
+        publisher.publish();
+
+        EXPECT_EQ(levelsOf(*held, Side::Buy), (std::vector<Level>{{99, 10, 1}}));
+        EXPECT_GT(publisher.retiredCount(), 0u);
+    }
+    publisher.publish();
+
+    EXPECT_EQ(publisher.retiredCount(), 0u);
+    EXPECT_TRUE(levelsOf(*publisher.read(reader), Side::Buy).empty());
+}
+
+TEST_F(DepthSnapshotTest, TracksLadderBookThroughRandomFlow) {
+    InstrumentSpec instrument(TickLadder{}, PriceBand{800, 1200});
+    LadderOrderBook ladder(&instrument);
+    BasicMatchingEngine<LadderOrderBook> ladderEngine(&stpPolicy, &ladder);
+    DepthPublisher<LadderOrderBook> publisher(&ladder);
+    uint32_t reader = *publisher.registerReader();
+    uint64_t state = 99;
+    for (OrderID id = 1; id <= 5000; ++id) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (state % 5 == 0 && id > 10) {
+            OrderID target = static_cast<OrderID>(1 + (state >> 8) % (id - 1));
+            if (ladder.removeOrder(target) == RejectionReason::None) {
+                orders[target - 1]->setStatus(OrderStatus::Cancelled);
+            }
+            make(id, 0, 0, Side::Buy);
+            continue;
+        }
+        Side side = (state >> 4) & 1 ? Side::Buy : Side::Sell;
+        PriceTicks price = side == Side::Buy ? 1000 - static_cast<PriceTicks>((state >> 12) % 150) + 3
+                                             : 1000 + static_cast<PriceTicks>((state >> 12) % 150) - 3;
+        ladderEngine.matchOrder(make(id, price, static_cast<Quantity>(1 + (state >> 24) % 30), side));
+        if (id % 97 == 0) {
+            publisher.publish();
+            auto snapshot = publisher.read(reader);
+            ASSERT_EQ(levelsOf(*snapshot, Side::Buy), levelsOf(ladder.getBids()));
+            ASSERT_EQ(levelsOf(*snapshot, Side::Sell), levelsOf(ladder.getAsks()));
+        }
+    }
+}
+
+TEST_F(DepthSnapshotTest, ConcurrentReadersSeeConsistentSnapshots) {
+    DepthPublisher<LimitOrderBook> publisher(&book);
+    std::atomic<bool> done{false};
+    std::atomic<bool> inconsistent{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            uint32_t id = *publisher.registerReader();
+            uint64_t lastVersion = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                auto snapshot = publisher.read(id);
+                int64_t total = 0;
+                size_t levels = 0;
+                snapshot->forEachLevel(Side::Buy, [&](PriceTicks, int64_t qty, uint32_t) {
+                    total += qty;
+                    ++levels;
+                    return true;
+                });
+                // Every bid level carries 10 per order and the writer adds one level per publish.
+                if (levels != snapshot->levelCount(Side::Buy) || total != 10 * static_cast<int64_t>(levels)) inconsistent = true;
+                if (snapshot->getVersion() < lastVersion) inconsistent = true;
+                lastVersion = snapshot->getVersion();
+            }
+        });
+    }
+    for (OrderID id = 1; id <= 3000; ++id) {
+        book.addOrder(make(id, 10 + id, 10, Side::Buy));
+        publisher.publish();
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_FALSE(inconsistent.load());
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "models/engine_host.hpp"
+
+namespace {
+struct RecordingListener {
+    std::vector<OrderID> submitted;
+    std::vector<Quantity> filled;
+    std::vector<std::pair<OrderID, RejectionReason>> cancels;
+    size_t fills = 0;
+
+    void onSubmit(const OrderPtr &order, const MatchOutcome &outcome, std::span<const Fill> lastFills) {
+        submitted.push_back(order->getOrderID());
+        filled.push_back(outcome ? outcome->filledQty : 0);
+        fills += lastFills.size();
+    }
+
+    void onCancel(const OrderPtr &order, RejectionReason result) {
+        cancels.emplace_back(order->getOrderID(), result);
+    }
+};
+}
+
+TEST(EngineHostTest, ProcessesCommandsInOrderAfterWarmUp) {
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    EngineHostConfig config;
+    config.warmupOrders = 5000;
+    EngineHost<LimitOrderBook, RecordingListener> host(&book, &stpPolicy, config);
+    std::deque<Order> orders;
+    orders.emplace_back(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1);
+    orders.emplace_back(2, 2, 101, 10, Side::Sell, OrderType::Limit, 2);
+    orders.emplace_back(3, 3, 0, 15, Side::Buy, OrderType::Market, 3);
+
+    host.start();
+    host.waitUntilReady();
+    EXPECT_TRUE(book.getBestAsk() == std::nullopt && book.getBestBid() == std::nullopt);
+    for (auto& order : orders) host.submit(&order);
+    host.cancel(&orders[1]);
+    host.cancel(&orders[0]);
+    host.stop();
+
+    const RecordingListener& listener = host.getListener();
+    EXPECT_EQ(listener.submitted, (std::vector<OrderID>{1, 2, 3}));
+    EXPECT_EQ(listener.filled, (std::vector<Quantity>{0, 0, 15}));
+    EXPECT_EQ(listener.fills, 2u);
+    ASSERT_EQ(listener.cancels.size(), 2u);
+    EXPECT_EQ(listener.cancels[0].second, RejectionReason::None);
+    EXPECT_EQ(listener.cancels[1].second, RejectionReason::OrderToBeRemovedDoesNotExist);
+    EXPECT_EQ(orders[1].getStatus(), OrderStatus::CancelledAfterPartialExecution);
+    EXPECT_FALSE(book.getBestAsk().has_value());
+    EXPECT_EQ(host.getStats().commands, 5u);
+    EXPECT_EQ(host.getStats().warmupOrders, 5000u);
+}
+
+TEST(EngineHostTest, BacksOffWhenIdleAndPinsToAnAllowedCore) {
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    EngineHostConfig config;
+    config.idleWait = IdleWait::SpinThenSleep;
+    config.spinsBeforeBackoff = 16;
+    config.warmupOrders = 0;
+    config.core = sched_getcpu();
+    EngineHost<LimitOrderBook> host(&book, &stpPolicy, config);
+    Order order(1, 1, 100, 10, Side::Buy, OrderType::Limit, 1);
+
+    host.start();
+    host.waitUntilReady();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    host.submit(&order);
+    host.stop();
+
+    EXPECT_TRUE(host.getStats().pinned);
+    EXPECT_GT(host.getStats().backoffs, 0u);
+    EXPECT_EQ(host.getStats().commands, 1u);
+    EXPECT_EQ(book.getBestBid(), 100);
+}
+
+TEST(EngineHostTest, RestartWarmsUpAgainWithFreshStats) {
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    EngineHostConfig config;
+    config.warmupOrders = 2000;
+    EngineHost<LimitOrderBook> host(&book, &stpPolicy, config);
+    Order first(1, 1, 100, 10, Side::Buy, OrderType::Limit, 1);
+    Order second(2, 2, 99, 10, Side::Buy, OrderType::Limit, 2);
+
+    host.start();
+    host.waitUntilReady();
+    host.submit(&first);
+    host.stop();
+    EXPECT_EQ(host.getStats().commands, 1u);
+
+    host.start();
+    host.waitUntilReady();
+    EXPECT_EQ(host.getStats().warmupOrders, 2000u);
+    host.submit(&second);
+    host.stop();
+
+    EXPECT_EQ(host.getStats().commands, 1u);
+    EXPECT_EQ(book.getOrderCount(), 2u);
+}
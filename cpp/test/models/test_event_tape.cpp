@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "models/event_tape.hpp"
+#include "models/matching_engine.hpp"
+#include "order_store.hpp"
+
+namespace {
+std::vector<std::byte> bytesOf(const std::stringstream &stream) {
+    std::string text = stream.str();
+    std::vector<std::byte> data(text.size());
+    std::memcpy(data.data(), text.data(), text.size());
+    return data;
+}
+}
+
+TEST(TapeCodecTest, ZigzagVarintRoundTrips) {
+    for (int64_t value : {int64_t{0}, int64_t{1}, int64_t{-1}, int64_t{63}, int64_t{-64}, INT64_MAX, INT64_MIN}) {
+        std::vector<uint8_t> bytes;
+        TapeCodec::putVarint(bytes, TapeCodec::zigzag(value));
+        const uint8_t* in = bytes.data();
+        uint64_t raw;
+        ASSERT_TRUE(TapeCodec::getVarint(in, bytes.data() + bytes.size(), raw));
+        EXPECT_EQ(TapeCodec::unzigzag(raw), value);
+        EXPECT_EQ(in, bytes.data() + bytes.size());
+    }
+}
+
+TEST(TapeWriterTest, EngineFillsAndOrderEventsRoundTrip) {
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine(&stpPolicy, &book);
+    OrderStore orders;
+    std::vector<TapeRecord> expected;
+    std::stringstream stream;
+    {
+        TapeWriter tape(stream, 1024, 64);
+        for (OrderID id = 1; id <= 1000; ++id) {
+            Side side = id % 2 ? Side::Buy : Side::Sell;
+            PriceTicks price = side == Side::Buy ? 100 + id % 3 : 101 - id % 3;
+            orders.add(id, id % 7, price, static_cast<Quantity>(1 + id % 9), side, OrderType::Limit, 1000 + id);
+            MatchOutcome outcome = engine.matchOrder(orders.back());
+            for (const Fill& fill : engine.getLastFills()) expected.push_back(TapeRecord::fromFill(fill));
+            tape.appendFills(engine.getLastFills());
+            if (outcome && outcome->resting) {
+                TapeRecord accepted = TapeRecord::fromOrder(TapeEventKind::Accepted, *orders.back());
+                expected.push_back(accepted);
+                tape.append(accepted);
+            }
+        }
+        tape.close();
+        EXPECT_EQ(tape.getWrittenCount(), expected.size());
+        EXPECT_EQ(tape.getAppendedCount(), expected.size());
+    }
+
+    std::vector<TapeRecord> records;
+    EXPECT_EQ(TapeReader::read(bytesOf(stream), records), TapeError::None);
+    EXPECT_EQ(records, expected);
+}
+
+TEST(TapeWriterTest, EncodesSmallerThanRawRecords) {
+    std::stringstream stream;
+    constexpr uint32_t COUNT = 100000;
+    {
+        TapeWriter tape(stream);
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            tape.append(TapeRecord{1'700'000'000'000'000'000ull + i * 250, 10000 + (i % 5), i + 1, i, i % 16, 100, TapeEventKind::Fill, Side::Sell});
+        }
+    }
+
+    std::vector<TapeRecord> records;
+    ASSERT_EQ(TapeReader::read(bytesOf(stream), records), TapeError::None);
+    ASSERT_EQ(records.size(), COUNT);
+    EXPECT_EQ(records.back().timestamp, 1'700'000'000'000'000'000ull + (COUNT - 1) * 250);
+    EXPECT_LT(stream.str().size(), COUNT * sizeof(TapeRecord) / 3);
+}
+
+TEST(TapeReaderTest, RejectsDamagedTapes) {
+    std::stringstream stream;
+    {
+        TapeWriter tape(stream);
+        for (uint32_t i = 0; i < 100; ++i) tape.append(TapeRecord{i, 100, i, 0, 1, 5, TapeEventKind::Accepted, Side::Buy});
+    }
+    std::vector<std::byte> data = bytesOf(stream);
+    std::vector<TapeRecord> records;
+
+    std::vector<std::byte> truncated(data.begin(), data.end() - 3);
+    EXPECT_EQ(TapeReader::read(truncated, records), TapeError::Truncated);
+
+    std::vector<std::byte> badMagic = data;
+    badMagic[0] = std::byte{0};
+    EXPECT_EQ(TapeReader::read(badMagic, records), TapeError::BadMagic);
+
+    std::vector<std::byte> badVersion = data;
+    badVersion[4] = std::byte{9};
+    EXPECT_EQ(TapeReader::read(badVersion, records), TapeError::UnsupportedVersion);
+
+    // Overlong varint in the timestamp column.
+    std::vector<std::byte> corrupt = data;
+    size_t firstColumn = sizeof(TapeHeader) + sizeof(TapeChunkHeader);
+    for (size_t i = 0; i < 11; ++i) corrupt[firstColumn + i] = std::byte{0xFF};
+    EXPECT_EQ(TapeReader::read(corrupt, records), TapeError::CorruptColumn);
+}
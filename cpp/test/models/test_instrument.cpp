@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "models/order_book.hpp"
+
+TEST(TickLadderTest, DefaultLadderAcceptsEveryPositiveTick) {
+    TickLadder ladder;
+
+    EXPECT_FALSE(ladder.isValidPrice(0));
+    EXPECT_TRUE(ladder.isValidPrice(1));
+    EXPECT_TRUE(ladder.isValidPrice(12345));
+}
+
+TEST(TickLadderTest, PriceDependentTiers) {
+    TickLadder ladder({{1, 1}, {1000, 5}, {5000, 25}});
+
+    EXPECT_TRUE(ladder.isValidPrice(999));
+    EXPECT_TRUE(ladder.isValidPrice(1000));
+    EXPECT_FALSE(ladder.isValidPrice(1001));
+    EXPECT_TRUE(ladder.isValidPrice(1005));
+    EXPECT_TRUE(ladder.isValidPrice(4995));
+    EXPECT_TRUE(ladder.isValidPrice(5025));
+    EXPECT_FALSE(ladder.isValidPrice(5005));
+}
+
+TEST(TickLadderTest, RejectsUnsortedTiersAndNonPositiveIncrements) {
+    EXPECT_THROW(TickLadder({{1, 0}}), std::invalid_argument);
+    EXPECT_THROW(TickLadder({{1, 1}, {1000, -5}}), std::invalid_argument);
+    EXPECT_THROW(TickLadder({{1000, 5}, {1, 1}}), std::invalid_argument);
+    EXPECT_THROW(TickLadder({{1, 1}, {1, 5}}), std::invalid_argument);
+    EXPECT_NO_THROW(TickLadder({{1, 1}, {1000, 5}}));
+}
+
+TEST(PriceBandTest, AroundReferenceUsesBasisPoints) {
+    PriceBand band = PriceBand::aroundReference(10000, 500);
+
+    EXPECT_EQ(band.low, 9500);
+    EXPECT_EQ(band.high, 10500);
+    EXPECT_EQ(band.width(), 1001);
+    EXPECT_TRUE(band.contains(9500));
+    EXPECT_TRUE(band.contains(10500));
+    EXPECT_FALSE(band.contains(9499));
+    EXPECT_FALSE(band.contains(10501));
+}
+
+class InstrumentValidationTest : public ::testing::Test {
+protected:
+    InstrumentSpec instrument{TickLadder({{1, 1}, {1000, 5}}), PriceBand{900, 1100}};
+    LimitOrderBook book{&instrument};
+};
+
+TEST_F(InstrumentValidationTest, RejectsPricesOutsideBand) {
+    auto low = std::make_unique<Order>(1, 1, 899, 10, Side::Buy, OrderType::Limit, 1000);
+    auto high = std::make_unique<Order>(2, 2, 1105, 10, Side::Sell, OrderType::Limit, 1001);
+
+    EXPECT_EQ(book.addOrder(low.get()), RejectionReason::PriceOutsideBand);
+    EXPECT_EQ(book.addOrder(high.get()), RejectionReason::PriceOutsideBand);
+    EXPECT_FALSE(book.doesOrderExist(1));
+    EXPECT_FALSE(book.doesOrderExist(2));
+}
+
+TEST_F(InstrumentValidationTest, RejectsPricesOffTheLadder) {
+    auto offTick = std::make_unique<Order>(1, 1, 1003, 10, Side::Sell, OrderType::Limit, 1000);
+    auto onTick = std::make_unique<Order>(2, 2, 1005, 10, Side::Sell, OrderType::Limit, 1001);
+    auto lowerTier = std::make_unique<Order>(3, 3, 999, 10, Side::Buy, OrderType::Limit, 1002);
+
+    EXPECT_EQ(book.addOrder(offTick.get()), RejectionReason::PriceNotOnTick);
+    EXPECT_EQ(book.addOrder(onTick.get()), RejectionReason::None);
+    EXPECT_EQ(book.addOrder(lowerTier.get()), RejectionReason::None);
+}
+
+TEST_F(InstrumentValidationTest, MarketOrdersSkipPriceChecks) {
+    auto market = std::make_unique<Order>(1, 1, 0, 10, Side::Buy, OrderType::Market, 1000);
+
+    EXPECT_EQ(OrderValidator::validatePrice(market.get(), &instrument), RejectionReason::None);
+}
+
+TEST_F(InstrumentValidationTest, BookWithoutInstrumentKeepsPositivePriceRule) {
+    LimitOrderBook plainBook;
+    auto farAway = std::make_unique<Order>(1, 1, 1000000, 10, Side::Buy, OrderType::Limit, 1000);
+
+    EXPECT_EQ(plainBook.getInstrumentSpec(), nullptr);
+    EXPECT_EQ(plainBook.addOrder(farAway.get()), RejectionReason::None);
+}
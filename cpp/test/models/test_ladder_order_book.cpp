@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "models/book_checkpoint.hpp"
+#include "models/matching_engine.hpp"
+#include "order_store.hpp"
+
+class LadderOrderBookTest : public ::testing::Test {
+protected:
+    InstrumentSpec instrument{TickLadder(), PriceBand{1, 10000}};
+    LadderOrderBook book{&instrument};
+    OrderStore orders;
+
+    OrderPtr make(OrderID id, PriceTicks price, Quantity qty, Side side, OrderType type = OrderType::Limit) {
+        orders.add(id, id, price, qty, side, type, 1000 + id);
+        return orders.back();
+    }
+};
+
+TEST_F(LadderOrderBookTest, BestPricesFollowAddsAndRemoves) {
+    book.addOrder(make(1, 100, 10, Side::Buy));
+    book.addOrder(make(2, 105, 10, Side::Buy));
+    book.addOrder(make(3, 110, 10, Side::Sell));
+    book.addOrder(make(4, 9000, 10, Side::Sell));
+
+    EXPECT_EQ(book.getBestBid(), 105);
+    EXPECT_EQ(book.getBestAsk(), 110);
+
+    EXPECT_EQ(book.removeOrder(2), RejectionReason::None);
+    EXPECT_EQ(book.removeOrder(3), RejectionReason::None);
+    EXPECT_EQ(book.getBestBid(), 100);
+    EXPECT_EQ(book.getBestAsk(), 9000);
+
+    EXPECT_EQ(book.removeOrder(1), RejectionReason::None);
+    EXPECT_EQ(book.removeOrder(4), RejectionReason::None);
+    EXPECT_EQ(book.getBestBid(), std::nullopt);
+    EXPECT_EQ(book.getBestAsk(), std::nullopt);
+}
+
+TEST_F(LadderOrderBookTest, PopFrontMovesToNextPopulatedLevel) {
+    book.addOrder(make(1, 100, 10, Side::Sell));
+    book.addOrder(make(2, 100, 10, Side::Sell));
+    book.addOrder(make(3, 7000, 10, Side::Sell));
+
+    book.popFront(Side::Buy);
+    EXPECT_EQ(book.getMatchedOrder(Side::Buy)->getOrderID(), 2u);
+    book.popFront(Side::Buy);
+    EXPECT_EQ(book.getBestAsk(), 7000);
+    book.popFront(Side::Buy);
+    EXPECT_EQ(book.getMatchedOrder(Side::Buy), nullptr);
+    EXPECT_NO_THROW(book.popFront(Side::Buy));
+}
+
+TEST_F(LadderOrderBookTest, BookWithoutInstrumentRejectsEverything) {
+    LadderOrderBook unsized;
+
+    EXPECT_EQ(unsized.addOrder(make(1, 100, 10, Side::Buy)), RejectionReason::PriceOutsideBand);
+    EXPECT_FALSE(unsized.doesOrderExist(1));
+}
+
+TEST_F(LadderOrderBookTest, MatchingEngineRunsOverLadder) {
+    CancelBothSTP stpPolicy;
+    BasicMatchingEngine<LadderOrderBook> engine(&stpPolicy, &book);
+    OrderPtr ask1 = make(1, 100, 5, Side::Sell);
+    OrderPtr ask2 = make(2, 103, 5, Side::Sell);
+    OrderPtr buy = make(3, 103, 8, Side::Buy);
+
+    engine.matchOrder(ask1);
+    engine.matchOrder(ask2);
+    engine.matchOrder(buy);
+
+    EXPECT_EQ(buy->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(ask1->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(ask2->getStatus(), OrderStatus::PartiallyExecuted);
+    EXPECT_EQ(ask2->getQty(), 2);
+    EXPECT_EQ(book.getBestAsk(), 103);
+    EXPECT_EQ(book.estimateImpact(Side::Buy, 100).filledQty, 2);
+}
+
+TEST_F(LadderOrderBookTest, CheckpointRestoresIntoLadder) {
+    LimitOrderBook mapBook;
+    mapBook.addOrder(make(1, 100, 10, Side::Buy));
+    mapBook.addOrder(make(2, 100, 20, Side::Buy));
+    mapBook.addOrder(make(3, 200, 30, Side::Sell));
+    std::vector<std::byte> data = BookCheckpoint::save(mapBook);
+
+    std::vector<Order> storage;
+    ASSERT_EQ(BookCheckpoint::load(data, book, storage), CheckpointError::None);
+
+    EXPECT_EQ(book.getBestBid(), 100);
+    EXPECT_EQ(book.getBestAsk(), 200);
+    EXPECT_EQ(book.getMatchedOrder(Side::Sell)->getOrderID(), 1u);
+    EXPECT_EQ(BookCheckpoint::save(book), data);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "models/matching_engine.hpp"
+#include "order_store.hpp"
+
+namespace {
+// Lets self-trades through, as a venue that only flags them would.
+class AllowSelfTradeSTP final : public STPPolicy {
+    public:
+        STPDecision getDecision() const override { return STPDecision{}; }
+};
+}
+
+class MatchingEngineAllocationTest : public ::testing::Test {
+protected:
+    LimitOrderBook orderBook;
+    CancelRestingSTP stpPolicy;
+    ProRataAllocation proRata{1};
+    MatchingEngine engine{&stpPolicy, &orderBook, &proRata};
+    OrderStore orders;
+
+    OrderPtr submit(OwnerID owner, PriceTicks price, Quantity qty, Side side, OrderType type = OrderType::Limit) {
+        orders.add(orders.size() + 1, owner, price, qty, side, type, 1000 + orders.size());
+        engine.matchOrder(orders.back());
+        return orders.back();
+    }
+};
+
+TEST_F(MatchingEngineAllocationTest, ProRataSplitsWithinLevel) {
+    OrderPtr small = submit(1, 100, 10, Side::Sell);
+    OrderPtr large = submit(2, 100, 30, Side::Sell);
+    OrderPtr buy = submit(3, 100, 20, Side::Buy);
+
+    EXPECT_EQ(buy->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(small->getQty(), 5);
+    EXPECT_EQ(large->getQty(), 15);
+    EXPECT_EQ(small->getStatus(), OrderStatus::PartiallyExecuted);
+    EXPECT_EQ(large->getStatus(), OrderStatus::PartiallyExecuted);
+    EXPECT_EQ(orderBook.estimateImpact(Side::Buy, 100).filledQty, 20);
+}
+
+TEST_F(MatchingEngineAllocationTest, SweepsLevelsAndRestsRemainder) {
+    OrderPtr ask1 = submit(1, 100, 10, Side::Sell);
+    OrderPtr ask2 = submit(2, 101, 10, Side::Sell);
+    OrderPtr buy = submit(3, 101, 25, Side::Buy);
+
+    EXPECT_EQ(ask1->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(ask2->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(buy->getStatus(), OrderStatus::PartiallyExecuted);
+    EXPECT_EQ(buy->getQty(), 5);
+    EXPECT_FALSE(orderBook.doesOrderExist(1));
+    EXPECT_FALSE(orderBook.doesOrderExist(2));
+    EXPECT_EQ(orderBook.getBestBid(), 101);
+    EXPECT_EQ(orderBook.getBestAsk(), std::nullopt);
+}
+
+TEST_F(MatchingEngineAllocationTest, SelfTradeOrdersLeaveTheLevelBeforeAllocation) {
+    OrderPtr own = submit(1, 100, 10, Side::Sell);
+    OrderPtr other = submit(2, 100, 10, Side::Sell);
+    OrderPtr buy = submit(1, 100, 10, Side::Buy);
+
+    EXPECT_EQ(own->getStatus(), OrderStatus::Cancelled);
+    EXPECT_FALSE(orderBook.doesOrderExist(1));
+    EXPECT_EQ(other->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(buy->getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(orderBook.getBestAsk(), std::nullopt);
+}
+
+TEST(MatchingEngineLmmTest, LeadMarketMakerFilledFirst) {
+    LimitOrderBook orderBook;
+    CancelBothSTP stpPolicy;
+    LmmFifoAllocation lmm({7}, 100);
+    MatchingEngine engine(&stpPolicy, &orderBook, &lmm);
+    Order early(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1000);
+    Order leadMaker(2, 7, 100, 10, Side::Sell, OrderType::Limit, 1001);
+    Order buy(3, 3, 0, 10, Side::Buy, OrderType::Market, 1002);
+
+    engine.matchOrder(&early);
+    engine.matchOrder(&leadMaker);
+    engine.matchOrder(&buy);
+
+    EXPECT_EQ(leadMaker.getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(early.getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(early.getQty(), 10);
+    EXPECT_EQ(buy.getStatus(), OrderStatus::Executed);
+}
+
+TEST(MatchingEngineFifoAllocationTest, MatchesDefaultPathAroundSelfTrades) {
+    CancelIncomingSTP stpPolicy;
+    FifoAllocation fifo;
+    for (AllocationPolicy* policy : {static_cast<AllocationPolicy*>(nullptr), static_cast<AllocationPolicy*>(&fifo)}) {
+        LimitOrderBook orderBook;
+        MatchingEngine engine(&stpPolicy, &orderBook, policy);
+        Order other(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1000);
+        Order own(2, 2, 100, 10, Side::Sell, OrderType::Limit, 1001);
+        Order buy(3, 2, 100, 5, Side::Buy, OrderType::Limit, 1002);
+
+        engine.matchOrder(&other);
+        engine.matchOrder(&own);
+        MatchOutcome outcome = engine.matchOrder(&buy);
+
+        ASSERT_TRUE(outcome.has_value());
+        EXPECT_EQ(buy.getStatus(), OrderStatus::Executed);
+        EXPECT_EQ(outcome->filledQty, 5);
+        ASSERT_EQ(engine.getLastFills().size(), 1u);
+        EXPECT_EQ(engine.getLastFills()[0].makerOrderID, 1u);
+        EXPECT_EQ(other.getQty(), 5);
+        EXPECT_EQ(own.getStatus(), OrderStatus::Pending);
+    }
+}
+
+TEST(MatchingEngineFifoAllocationTest, SelfTradeDecisionThatCancelsNothingTrades) {
+    AllowSelfTradeSTP stpPolicy;
+    ProRataAllocation proRata{1};
+    LimitOrderBook orderBook;
+    MatchingEngine engine(&stpPolicy, &orderBook, &proRata);
+    Order own(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1000);
+    Order other(2, 2, 100, 10, Side::Sell, OrderType::Limit, 1001);
+    Order buy(3, 1, 100, 10, Side::Buy, OrderType::Limit, 1002);
+
+    engine.matchOrder(&own);
+    engine.matchOrder(&other);
+    MatchOutcome outcome = engine.matchOrder(&buy);
+
+    ASSERT_TRUE(outcome.has_value());
+    EXPECT_EQ(outcome->filledQty, 10);
+    EXPECT_EQ(own.getQty(), 5);
+    EXPECT_EQ(other.getQty(), 5);
+    EXPECT_EQ(buy.getStatus(), OrderStatus::Executed);
+}
@@ -637,4 +637,137 @@ TEST_F(MatchingEngineMatchTest, MultipleMarketOrders) {
 
     delete sellOrder1;
     delete buyOrder1;
-}
\ No newline at end of file
+}
+
+TEST(MatchingEnginePriceBandTest, OutOfBandLimitOrderIsCancelledBeforeMatching) {
+    InstrumentSpec instrument{TickLadder(), PriceBand{90, 110}};
+    LimitOrderBook orderBook(&instrument);
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine(&stpPolicy, &orderBook);
+    OrderPtr sellOrder = new Order(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1622547800);
+    OrderPtr buyOrder = new Order(2, 2, 500, 10, Side::Buy, OrderType::Limit, 1622547801);
+
+    engine.matchOrder(sellOrder);
+    engine.matchOrder(buyOrder);
+
+    EXPECT_EQ(buyOrder->getStatus(), OrderStatus::Cancelled);
+    EXPECT_EQ(buyOrder->getQty(), 10);
+    EXPECT_EQ(sellOrder->getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(sellOrder->getQty(), 10);
+    EXPECT_EQ(orderBook.getBestAsk(), 100);
+    EXPECT_EQ(orderBook.getBestBid(), std::nullopt);
+
+    delete sellOrder;
+    delete buyOrder;
+}
+
+
+TEST_F(MatchingEngineMatchTest, LevelAggregatesFollowPartialFills) {
+    OrderPtr sellOrder1 = new Order(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1622547800);
+    OrderPtr sellOrder2 = new Order(2, 2, 101, 10, Side::Sell, OrderType::Limit, 1622547801);
+    OrderPtr buyOrder = new Order(3, 3, 100, 4, Side::Buy, OrderType::Limit, 1622547802);
+
+    engine->matchOrder(sellOrder1);
+    engine->matchOrder(sellOrder2);
+    engine->matchOrder(buyOrder);
+
+    ImpactEstimate estimate = orderBook->estimateImpact(Side::Buy, 100);
+    EXPECT_EQ(estimate.filledQty, 16);
+    EXPECT_EQ(estimate.notional, 6 * 100 + 10 * 101);
+
+    delete sellOrder1;
+    delete sellOrder2;
+    delete buyOrder;
+}
+
+TEST_F(MatchingEngineMatchTest, ResultReportsFillsAndAveragePrice) {
+    OrderPtr sell1 = new Order(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1622547800);
+    OrderPtr sell2 = new Order(2, 2, 102, 10, Side::Sell, OrderType::Limit, 1622547801);
+    OrderPtr buy = new Order(3, 3, 105, 25, Side::Buy, OrderType::Limit, 1622547802);
+    engine->matchOrder(sell1);
+    engine->matchOrder(sell2);
+
+    MatchOutcome outcome = engine->matchOrder(buy);
+
+    ASSERT_TRUE(outcome.has_value());
+    EXPECT_EQ(outcome->finalStatus, OrderStatus::PartiallyExecuted);
+    EXPECT_EQ(outcome->filledQty, 20);
+    EXPECT_EQ(outcome->notional, 100 * 10 + 102 * 10);
+    EXPECT_DOUBLE_EQ(outcome->averagePrice(), 101.0);
+    EXPECT_EQ(outcome->firstFill, 0u);
+    EXPECT_EQ(outcome->fillCount, 2u);
+    EXPECT_EQ(engine->getLastFills().size(), outcome->fillCount);
+    EXPECT_TRUE(outcome->resting);
+    EXPECT_EQ(outcome->restRejection, RejectionReason::None);
+
+    delete sell1;
+    delete sell2;
+    delete buy;
+}
+
+TEST_F(MatchingEngineMatchTest, MarketRemainderIsNotResting) {
+    OrderPtr sell = new Order(1, 1, 100, 5, Side::Sell, OrderType::Limit, 1622547800);
+    OrderPtr buy = new Order(2, 2, 0, 8, Side::Buy, OrderType::Market, 1622547801);
+    engine->matchOrder(sell);
+
+    MatchOutcome outcome = engine->matchOrder(buy);
+
+    ASSERT_TRUE(outcome.has_value());
+    EXPECT_EQ(outcome->finalStatus, OrderStatus::CancelledAfterPartialExecution);
+    EXPECT_EQ(outcome->filledQty, 5);
+    EXPECT_FALSE(outcome->resting);
+
+    delete sell;
+    delete buy;
+}
+
+TEST_F(MatchingEngineMatchTest, DuplicateRemainderIsCancelledAndReported) {
+    OrderPtr first = new Order(1, 1, 100, 5, Side::Buy, OrderType::Limit, 1622547800);
+    OrderPtr duplicate = new Order(1, 2, 99, 5, Side::Buy, OrderType::Limit, 1622547801);
+    engine->matchOrder(first);
+
+    MatchOutcome outcome = engine->matchOrder(duplicate);
+
+    ASSERT_TRUE(outcome.has_value());
+    EXPECT_FALSE(outcome->resting);
+    EXPECT_EQ(outcome->restRejection, RejectionReason::AddingDuplicateOrder);
+    EXPECT_EQ(outcome->finalStatus, OrderStatus::Cancelled);
+    EXPECT_EQ(duplicate->getStatus(), OrderStatus::Cancelled);
+
+    delete first;
+    delete duplicate;
+}
+
+TEST_F(MatchingEngineMatchTest, PriceCheckFailureIsUnexpected) {
+    InstrumentSpec instrument(TickLadder{}, PriceBand{90, 110});
+    LimitOrderBook bandedBook(&instrument);
+    MatchingEngine bandedEngine(stpPolicy, &bandedBook);
+    OrderPtr buy = new Order(1, 1, 150, 5, Side::Buy, OrderType::Limit, 1622547800);
+
+    MatchOutcome outcome = bandedEngine.matchOrder(buy);
+
+    ASSERT_FALSE(outcome.has_value());
+    EXPECT_EQ(outcome.error(), RejectionReason::PriceOutsideBand);
+    EXPECT_EQ(buy->getStatus(), OrderStatus::Cancelled);
+
+    delete buy;
+}
+
+TEST_F(MatchingEngineMatchTest, RestingRemainderCarriesBookHandle) {
+    OrderPtr sell = new Order(1, 1, 100, 5, Side::Sell, OrderType::Limit, 1622547800);
+    OrderPtr buy = new Order(2, 2, 100, 8, Side::Buy, OrderType::Limit, 1622547801);
+
+    MatchOutcome filled = engine->matchOrder(sell);
+    MatchOutcome outcome = engine->matchOrder(buy);
+
+    ASSERT_TRUE(filled.has_value());
+    ASSERT_TRUE(outcome.has_value());
+    EXPECT_TRUE(outcome->resting);
+    EXPECT_TRUE(orderBook->isLive(outcome->handle));
+    EXPECT_FALSE(orderBook->isLive(filled->handle));
+    EXPECT_EQ(orderBook->removeOrder(outcome->handle), RejectionReason::None);
+    EXPECT_EQ(orderBook->getBestBid(), std::nullopt);
+
+    delete sell;
+    delete buy;
+}
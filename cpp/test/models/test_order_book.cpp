@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
+#include <deque>
 #include <memory>
+#include <random>
 #include "models/order_book.hpp"
 
+static_assert(!std::is_copy_constructible_v<LimitOrderBook> && !std::is_copy_assignable_v<LimitOrderBook>);
+static_assert(!std::is_move_constructible_v<LadderOrderBook>);
+
 class OrderBookTest : public ::testing::Test {
 protected:
     LimitOrderBook book;
@@ -415,4 +420,382 @@ TEST_F(OrderBookTest, PopFrontSellRemovesEmptyBidLevel) {
 
     delete bid1;
     delete bid2;
-}
\ No newline at end of file
+}
+
+TEST_F(OrderBookTest, EstimateImpactOnEmptySide) {
+    ImpactEstimate estimate = book.estimateImpact(Side::Buy, 10);
+
+    EXPECT_EQ(estimate.filledQty, 0);
+    EXPECT_EQ(estimate.levelsConsumed, 0u);
+    EXPECT_EQ(estimate.worstPrice, 0);
+    EXPECT_DOUBLE_EQ(estimate.vwap(), 0.0);
+}
+
+TEST_F(OrderBookTest, EstimateImpactWalksLevelsWithoutMutating) {
+    OrderPtr ask1 = new Order(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1000);
+    OrderPtr ask2 = new Order(2, 2, 100, 5, Side::Sell, OrderType::Limit, 1001);
+    OrderPtr ask3 = new Order(3, 3, 102, 10, Side::Sell, OrderType::Limit, 1002);
+    OrderPtr bid1 = new Order(4, 4, 98, 20, Side::Buy, OrderType::Limit, 1003);
+    book.addOrder(ask1);
+    book.addOrder(ask2);
+    book.addOrder(ask3);
+    book.addOrder(bid1);
+
+    ImpactEstimate buy = book.estimateImpact(Side::Buy, 20);
+    EXPECT_EQ(buy.filledQty, 20);
+    EXPECT_EQ(buy.notional, 15 * 100 + 5 * 102);
+    EXPECT_EQ(buy.worstPrice, 102);
+    EXPECT_EQ(buy.levelsConsumed, 2u);
+    EXPECT_DOUBLE_EQ(buy.vwap(), 2010.0 / 20);
+
+    ImpactEstimate tooLarge = book.estimateImpact(Side::Buy, 100);
+    EXPECT_EQ(tooLarge.filledQty, 25);
+    EXPECT_EQ(tooLarge.levelsConsumed, 2u);
+
+    ImpactEstimate sell = book.estimateImpact(Side::Sell, 5);
+    EXPECT_EQ(sell.filledQty, 5);
+    EXPECT_EQ(sell.worstPrice, 98);
+    EXPECT_EQ(sell.levelsConsumed, 1u);
+
+    EXPECT_EQ(book.getMatchedOrder(Side::Buy), ask1);
+    EXPECT_EQ(ask1->getQty(), 10);
+
+    delete ask1;
+    delete ask2;
+    delete ask3;
+    delete bid1;
+}
+
+TEST_F(OrderBookTest, EstimateImpactForNotional) {
+    OrderPtr ask1 = new Order(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1000);
+    OrderPtr ask2 = new Order(2, 2, 110, 10, Side::Sell, OrderType::Limit, 1001);
+    book.addOrder(ask1);
+    book.addOrder(ask2);
+
+    ImpactEstimate estimate = book.estimateImpactForNotional(Side::Buy, 1000 + 3 * 110 + 50);
+
+    EXPECT_EQ(estimate.filledQty, 13);
+    EXPECT_EQ(estimate.notional, 1330);
+    EXPECT_EQ(estimate.worstPrice, 110);
+    EXPECT_EQ(estimate.levelsConsumed, 2u);
+
+    delete ask1;
+    delete ask2;
+}
+
+TEST_F(OrderBookTest, EstimateImpactTracksRemovalsAndPops) {
+    OrderPtr bid1 = new Order(1, 1, 100, 10, Side::Buy, OrderType::Limit, 1000);
+    OrderPtr bid2 = new Order(2, 2, 100, 7, Side::Buy, OrderType::Limit, 1001);
+    OrderPtr bid3 = new Order(3, 3, 100, 4, Side::Buy, OrderType::Limit, 1002);
+    book.addOrder(bid1);
+    book.addOrder(bid2);
+    book.addOrder(bid3);
+
+    book.removeOrder(2);
+    EXPECT_EQ(book.estimateImpact(Side::Sell, 100).filledQty, 14);
+
+    bid1->reduceQty(6);
+    book.reduceBestLevelQty(Side::Sell, 6);
+    EXPECT_EQ(book.estimateImpact(Side::Sell, 100).filledQty, 8);
+
+    book.popFront(Side::Sell);
+    EXPECT_EQ(book.estimateImpact(Side::Sell, 100).filledQty, 4);
+
+    delete bid1;
+    delete bid2;
+    delete bid3;
+}
+
+TEST_F(OrderBookTest, QueuePositionCountsQuantityAhead) {
+    std::vector<Order> orders;
+    orders.emplace_back(1, 1, 100, 10, Side::Buy, OrderType::Limit, 1000);
+    orders.emplace_back(2, 2, 100, 7, Side::Buy, OrderType::Limit, 1001);
+    orders.emplace_back(3, 3, 100, 4, Side::Buy, OrderType::Limit, 1002);
+    orders.emplace_back(4, 4, 99, 5, Side::Buy, OrderType::Limit, 1003);
+    for (Order& order : orders) book.addOrder(&order);
+
+    EXPECT_EQ(book.getQueuePosition(1)->qtyAhead, 0);
+    EXPECT_EQ(book.getQueuePosition(3)->qtyAhead, 17);
+    EXPECT_EQ(book.getQueuePosition(3)->levelQty, 21);
+    EXPECT_EQ(book.getQueuePosition(4)->qtyAhead, 0);
+    EXPECT_EQ(book.getQueuePosition(4)->price, 99);
+    EXPECT_FALSE(book.getQueuePosition(9).has_value());
+
+    orders[0].reduceQty(6);
+    book.reduceBestLevelQty(Side::Sell, 6);
+    EXPECT_EQ(book.getQueuePosition(3)->qtyAhead, 11);
+
+    orders[1].reduceQty(3);
+    EXPECT_EQ(book.reduceRestingQty(&orders[1], 3), RejectionReason::None);
+    EXPECT_EQ(book.getQueuePosition(3)->qtyAhead, 8);
+    EXPECT_EQ(book.getQueuePosition(3)->levelQty, 12);
+
+    book.removeOrder(2);
+    EXPECT_EQ(book.getQueuePosition(3)->qtyAhead, 4);
+    book.popFront(Side::Sell);
+    EXPECT_EQ(book.getQueuePosition(3)->qtyAhead, 0);
+    EXPECT_FALSE(book.getQueuePosition(1).has_value());
+}
+
+TEST_F(OrderBookTest, QueuePositionSurvivesCompactionUnderChurn) {
+    std::deque<Order> orders;
+    std::deque<OrderID> live;
+    std::mt19937 rng(3);
+    OrderID nextID = 1;
+    for (int step = 0; step < 5000; ++step) {
+        if (live.size() < 5 || rng() % 2) {
+            Order& order = orders.emplace_back(nextID, 1, 100, static_cast<Quantity>(1 + rng() % 50), Side::Sell, OrderType::Limit, nextID);
+            book.addOrder(&order);
+            live.push_back(nextID++);
+        } else {
+            size_t victim = rng() % live.size();
+            book.removeOrder(live[victim]);
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(victim));
+        }
+        if (step % 97 == 0) {
+            int64_t ahead = 0;
+            for (OrderID id : live) {
+                ASSERT_EQ(book.getQueuePosition(id)->qtyAhead, ahead);
+                ahead += orders[id - 1].getQty();
+            }
+        }
+    }
+}
+
+TEST_F(OrderBookTest, CancelAllForOwnerRemovesOnlyThatOwnersOrders) {
+    std::deque<Order> orders;
+    orders.emplace_back(1, 7, 100, 10, Side::Buy, OrderType::Limit, 1);
+    orders.emplace_back(2, 8, 100, 5, Side::Buy, OrderType::Limit, 2);
+    orders.emplace_back(3, 7, 99, 4, Side::Buy, OrderType::Limit, 3);
+    orders.emplace_back(4, 7, 105, 6, Side::Sell, OrderType::Limit, 4);
+    orders.emplace_back(5, 8, 106, 3, Side::Sell, OrderType::Limit, 5);
+    for (Order& order : orders) book.addOrder(&order);
+    EXPECT_EQ(book.countOwnerOrders(7, Side::Buy), 2u);
+
+    std::vector<OrderPtr> cancelled;
+    EXPECT_EQ(book.cancelAllForOwner(7, Side::Buy, &cancelled), 2u);
+
+    ASSERT_EQ(cancelled.size(), 2u);
+    EXPECT_EQ(cancelled[0]->getOrderID(), 1u);
+    EXPECT_EQ(cancelled[1]->getOrderID(), 3u);
+    EXPECT_EQ(orders[0].getStatus(), OrderStatus::Cancelled);
+    EXPECT_FALSE(book.doesOrderExist(1));
+    EXPECT_FALSE(book.doesOrderExist(3));
+    EXPECT_TRUE(book.doesOrderExist(4));
+    EXPECT_EQ(book.getBestBid(), 100);
+    EXPECT_EQ(book.getQueuePosition(2)->qtyAhead, 0);
+
+    EXPECT_EQ(book.cancelAllForOwner(7), 1u);
+    EXPECT_EQ(book.getBestAsk(), 106);
+    EXPECT_EQ(book.cancelAllForOwner(7), 0u);
+    EXPECT_EQ(book.cancelAllForOwner(42), 0u);
+    EXPECT_EQ(book.countOwnerOrders(8, Side::Buy) + book.countOwnerOrders(8, Side::Sell), 2u);
+}
+
+TEST_F(OrderBookTest, OwnerListsTrackPopsAndRemovals) {
+    std::deque<Order> orders;
+    for (OrderID id = 1; id <= 6; ++id) {
+        orders.emplace_back(id, id % 2, 100, 10, Side::Sell, OrderType::Limit, id);
+        book.addOrder(&orders.back());
+    }
+    book.popFront(Side::Buy);           // order 1, owner 1
+    book.removeOrder(4);                // owner 0
+    orders[1].reduceQty(10);
+    book.reduceBestLevelQty(Side::Buy, 10);
+    book.popFront(Side::Buy);           // order 2, owner 0
+
+    EXPECT_EQ(book.countOwnerOrders(1, Side::Sell), 2u);
+    EXPECT_EQ(book.countOwnerOrders(0, Side::Sell), 1u);
+    EXPECT_EQ(book.cancelAllForOwner(1), 2u);
+    EXPECT_EQ(book.getQueuePosition(6)->qtyAhead, 0);
+    EXPECT_EQ(book.getQueuePosition(6)->levelQty, 10);
+}
+
+TEST_F(OrderBookTest, BulkLoadBuildsLevelsQueuesAndIndex) {
+    std::deque<Order> orders;
+    orders.emplace_back(1, 1, 101, 5, Side::Buy, OrderType::Limit, 1);
+    orders.emplace_back(2, 2, 105, 3, Side::Sell, OrderType::Limit, 2);
+    orders.emplace_back(3, 1, 101, 7, Side::Buy, OrderType::Limit, 3);
+    orders.emplace_back(4, 3, 100, 2, Side::Buy, OrderType::Limit, 4);
+    orders.emplace_back(5, 2, 106, 4, Side::Sell, OrderType::Limit, 5);
+    std::vector<OrderPtr> handles;
+    for (Order& order : orders) handles.push_back(&order);
+
+    BulkLoadResult result = book.bulkLoad(handles);
+
+    EXPECT_EQ(result.reason, RejectionReason::None);
+    EXPECT_EQ(book.getOrderCount(), 5u);
+    EXPECT_EQ(book.getBestBid(), 101);
+    EXPECT_EQ(book.getBestAsk(), 105);
+    EXPECT_EQ(book.getMatchedOrder(Side::Sell)->getOrderID(), 1u);
+    EXPECT_EQ(book.getQueuePosition(3)->qtyAhead, 5);
+    EXPECT_EQ(book.getLevel(Side::Buy, 101)->totalQty, 12);
+    EXPECT_EQ(book.countOwnerOrders(1, Side::Buy), 2u);
+    EXPECT_EQ(book.removeOrder(4), RejectionReason::None);
+    EXPECT_EQ(book.bulkLoad(handles).reason, RejectionReason::BulkLoadIntoNonEmptyBook);
+}
+
+TEST_F(OrderBookTest, BulkLoadRejectsOutOfOrderInputAndLeavesBookEmpty) {
+    std::deque<Order> orders;
+    orders.emplace_back(1, 1, 100, 5, Side::Buy, OrderType::Limit, 1);
+    orders.emplace_back(2, 1, 101, 5, Side::Buy, OrderType::Limit, 2);
+    std::vector<OrderPtr> handles{&orders[0], &orders[1]};
+
+    BulkLoadResult result = book.bulkLoad(handles);
+
+    EXPECT_EQ(result.reason, RejectionReason::BulkLoadOutOfOrder);
+    EXPECT_EQ(result.index, 1u);
+    EXPECT_EQ(book.getOrderCount(), 0u);
+    EXPECT_FALSE(book.getBestBid().has_value());
+    EXPECT_EQ(book.countOwnerOrders(1, Side::Buy), 0u);
+
+    orders.emplace_back(1, 1, 99, 5, Side::Buy, OrderType::Limit, 3);
+    handles = {&orders[0], &orders[2]};
+    result = book.bulkLoad(handles);
+    EXPECT_EQ(result.reason, RejectionReason::AddingDuplicateOrder);
+    EXPECT_EQ(book.getOrderCount(), 0u);
+
+    handles = {&orders[1], &orders[0]};
+    EXPECT_EQ(book.bulkLoad(handles).reason, RejectionReason::None);
+    EXPECT_EQ(book.getBestBid(), 101);
+}
+
+TEST_F(OrderBookTest, HandleRemovesOrderAndGoesStale) {
+    std::deque<Order> orders;
+    orders.emplace_back(1, 1, 100, 5, Side::Buy, OrderType::Limit, 1);
+    orders.emplace_back(2, 1, 100, 3, Side::Buy, OrderType::Limit, 2);
+    OrderHandle first;
+    OrderHandle second;
+    book.addOrder(&orders[0], &first);
+    book.addOrder(&orders[1], &second);
+
+    EXPECT_FALSE(first.isNull());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(book.getQueuePosition(second)->qtyAhead, 5);
+    EXPECT_EQ(book.removeOrder(first), RejectionReason::None);
+    EXPECT_FALSE(book.isLive(first));
+    EXPECT_FALSE(book.doesOrderExist(1));
+    EXPECT_EQ(book.getOrderCount(), 1u);
+    EXPECT_EQ(book.getQueuePosition(second)->qtyAhead, 0);
+    EXPECT_EQ(book.countOwnerOrders(1, Side::Buy), 1u);
+    EXPECT_EQ(book.removeOrder(first), RejectionReason::OrderToBeRemovedDoesNotExist);
+    EXPECT_EQ(book.removeOrder(1), RejectionReason::OrderToBeRemovedDoesNotExist);
+
+    // The ID and the freed entry are reused; the old handle stays stale.
+    orders.emplace_back(1, 1, 101, 4, Side::Buy, OrderType::Limit, 3);
+    OrderHandle reused;
+    EXPECT_EQ(book.addOrder(&orders[2], &reused), RejectionReason::None);
+    EXPECT_EQ(reused.slot, first.slot);
+    EXPECT_FALSE(book.isLive(first));
+    EXPECT_EQ(book.getOrderCount(), 2u);
+    EXPECT_EQ(book.getBestBid(), 101);
+
+    EXPECT_EQ(book.removeOrder(second), RejectionReason::None);
+    EXPECT_FALSE(book.getLevel(Side::Buy, 100));
+    EXPECT_EQ(book.removeOrder(1), RejectionReason::None);
+    EXPECT_FALSE(book.isLive(reused));
+    EXPECT_FALSE(book.getBestBid().has_value());
+}
+
+TEST_F(OrderBookTest, ModifyQtyByHandleKeepsPriorityOnlyWhenReducing) {
+    std::deque<Order> orders;
+    orders.emplace_back(1, 1, 100, 10, Side::Sell, OrderType::Limit, 1);
+    orders.emplace_back(2, 2, 100, 6, Side::Sell, OrderType::Limit, 2);
+    OrderHandle handle;
+    book.addOrder(&orders[0], &handle);
+    book.addOrder(&orders[1]);
+
+    EXPECT_EQ(book.modifyQty(handle, 0), RejectionReason::InvalidQuantity);
+    EXPECT_EQ(book.modifyQty(handle, 4), RejectionReason::None);
+    EXPECT_EQ(orders[0].getQty(), 4);
+    EXPECT_EQ(book.getMatchedOrder(Side::Buy)->getOrderID(), 1u);
+    EXPECT_EQ(book.getQueuePosition(2)->qtyAhead, 4);
+    EXPECT_EQ(book.getLevel(Side::Sell, 100)->totalQty, 10);
+
+    EXPECT_EQ(book.modifyQty(handle, 9), RejectionReason::None);
+    EXPECT_EQ(orders[0].getQty(), 9);
+    EXPECT_EQ(book.getMatchedOrder(Side::Buy)->getOrderID(), 2u);
+    EXPECT_EQ(book.getQueuePosition(handle)->qtyAhead, 6);
+    EXPECT_EQ(book.getLevel(Side::Sell, 100)->totalQty, 15);
+
+    book.popFront(Side::Buy);
+    EXPECT_EQ(book.getQueuePosition(handle)->qtyAhead, 0);
+    book.popFront(Side::Buy);
+    EXPECT_EQ(book.modifyQty(handle, 3), RejectionReason::OrderToBeRemovedDoesNotExist);
+}
+
+TEST_F(OrderBookTest, StaleIDsArePurgedUnderHandleChurn) {
+    std::deque<Order> orders;
+    for (OrderID id = 1; id <= 5000; ++id) {
+        Order& order = orders.emplace_back(id, id % 7, 100 + id % 5, 1, Side::Buy, OrderType::Limit, id);
+        OrderHandle handle;
+        ASSERT_EQ(book.addOrder(&order, &handle), RejectionReason::None);
+        ASSERT_EQ(book.removeOrder(handle), RejectionReason::None);
+        ASSERT_EQ(book.getOrderCount(), 0u);
+    }
+
+    EXPECT_FALSE(book.getBestBid().has_value());
+    Order again(17, 1, 100, 2, Side::Buy, OrderType::Limit, 6000);
+    EXPECT_EQ(book.addOrder(&again), RejectionReason::None);
+    EXPECT_EQ(book.getOrderCount(), 1u);
+    EXPECT_EQ(book.getQueuePosition(17)->levelQty, 2);
+}
+
+TEST_F(OrderBookTest, ModifyQtyIncreaseSurvivesQueueCompaction) {
+    std::deque<Order> orders;
+    std::vector<OrderHandle> handles(9);
+    for (OrderID id = 1; id <= 8; ++id) {
+        orders.emplace_back(id, id, 100, 10, Side::Buy, OrderType::Limit, id);
+        book.addOrder(&orders.back(), &handles[id]);
+    }
+    for (OrderID id = 1; id <= 6; ++id) book.removeOrder(handles[id]);
+
+    EXPECT_EQ(book.modifyQty(handles[7], 50), RejectionReason::None);
+    EXPECT_EQ(book.getQueuePosition(handles[7])->qtyAhead, 10);
+    EXPECT_EQ(book.getQueuePosition(handles[7])->levelQty, 60);
+    EXPECT_EQ(book.getQueuePosition(handles[8])->qtyAhead, 0);
+
+    orders.emplace_back(9, 9, 100, 5, Side::Buy, OrderType::Limit, 9);
+    book.addOrder(&orders.back());
+    EXPECT_EQ(book.getQueuePosition(9)->qtyAhead, 60);
+}
+
+TEST_F(OrderBookTest, CloneCopiesQueuesHandlesAndOwnerListsIndependently) {
+    std::deque<Order> orders;
+    std::vector<OrderHandle> handles(6);
+    for (OrderID id = 1; id <= 5; ++id) {
+        Side side = id <= 3 ? Side::Buy : Side::Sell;
+        PriceTicks price = side == Side::Buy ? 100 - static_cast<PriceTicks>(id / 3) : 105;
+        orders.emplace_back(id, id % 2, price, static_cast<Quantity>(id * 10), side, OrderType::Limit, id);
+        book.addOrder(&orders.back(), &handles[id]);
+    }
+    book.removeOrder(handles[2]);
+
+    std::vector<Order> storage;
+    LimitOrderBook clone(book, storage);
+
+    EXPECT_EQ(storage.size(), 4u);
+    EXPECT_EQ(clone.getOrderCount(), 4u);
+    EXPECT_EQ(clone.getBestBid(), 100);
+    EXPECT_EQ(clone.getBestAsk(), 105);
+    EXPECT_FALSE(clone.doesOrderExist(2));
+    EXPECT_FALSE(clone.isLive(handles[2]));
+    EXPECT_EQ(clone.getQueuePosition(handles[5])->qtyAhead, 40);
+    EXPECT_EQ(clone.getQueuePosition(handles[5])->levelQty, 90);
+    EXPECT_EQ(clone.countOwnerOrders(1, Side::Buy), 2u);
+    EXPECT_EQ(clone.getMatchedOrder(Side::Buy)->getOrderID(), 4u);
+    EXPECT_NE(clone.getMatchedOrder(Side::Buy), &orders[3]);
+
+    EXPECT_EQ(clone.modifyQty(handles[5], 60), RejectionReason::None);
+    EXPECT_EQ(clone.removeOrder(handles[1]), RejectionReason::None);
+    EXPECT_EQ(clone.cancelAllForOwner(1), 2u);
+    EXPECT_EQ(orders[4].getQty(), 50);
+    EXPECT_EQ(orders[0].getStatus(), OrderStatus::Pending);
+    EXPECT_EQ(book.getOrderCount(), 4u);
+    EXPECT_EQ(book.getQueuePosition(handles[5])->levelQty, 90);
+    EXPECT_EQ(book.countOwnerOrders(1, Side::Buy), 2u);
+
+    orders.emplace_back(6, 0, 99, 1, Side::Buy, OrderType::Limit, 6);
+    EXPECT_EQ(clone.addOrder(&orders.back()), RejectionReason::None);
+    EXPECT_FALSE(book.doesOrderExist(6));
+}
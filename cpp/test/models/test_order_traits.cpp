@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "models/matching_engine.hpp"
+
+using CompactOrder = BasicOrder<CompactOrderTraits>;
+using WideIDOrder = BasicOrder<WideIDOrderTraits>;
+
+TEST(OrderTraitsTest, NarrowTypesShrinkTheOrder) {
+    EXPECT_EQ(sizeof(Order), 32u);
+    EXPECT_EQ(sizeof(CompactOrder), 24u);
+    EXPECT_EQ(sizeof(WideIDOrder), 40u);
+}
+
+TEST(OrderTraitsTest, CompactBookMatchesPriceTime) {
+    LimitOrderBookFor<CompactOrderTraits> book;
+    CancelBothSTP stpPolicy;
+    MatchingEngineFor<CompactOrderTraits> engine(&stpPolicy, &book);
+    std::deque<CompactOrder> orders;
+    auto submit = [&](uint32_t id, uint16_t owner, int32_t price, int16_t qty, Side side, OrderType type = OrderType::Limit) {
+        CompactOrder* order = &orders.emplace_back(id, owner, price, qty, side, type, id);
+        return engine.matchOrder(order);
+    };
+
+    submit(1, 1, 100, 300, Side::Sell);
+    submit(2, 2, 100, 200, Side::Sell);
+    submit(3, 3, 101, 100, Side::Sell);
+    MatchOutcome outcome = submit(4, 4, 0, 550, Side::Buy, OrderType::Market);
+
+    ASSERT_TRUE(outcome.has_value());
+    EXPECT_EQ(outcome->filledQty, 550);
+    EXPECT_EQ(outcome->notional, 500 * 100 + 50 * 101);
+    ASSERT_EQ(engine.getLastFills().size(), 3u);
+    EXPECT_EQ(engine.getLastFills()[0].makerOrderID, 1u);
+    EXPECT_EQ(engine.getLastFills()[1].makerOrderID, 2u);
+    EXPECT_EQ(orders[2].getQty(), 50);
+    EXPECT_EQ(book.getBestAsk(), 101);
+}
+
+TEST(OrderTraitsTest, CompactLadderBookWithProRata) {
+    InstrumentSpec instrument(TickLadder{}, PriceBand{90, 110});
+    LadderOrderBookFor<CompactOrderTraits> book(&instrument);
+    CancelBothSTP stpPolicy;
+    BasicProRataAllocation<CompactOrder> proRata;
+    BasicMatchingEngine<LadderOrderBookFor<CompactOrderTraits>> engine(&stpPolicy, &book, &proRata);
+    std::deque<CompactOrder> orders;
+    orders.emplace_back(1, 1, 100, 300, Side::Buy, OrderType::Limit, 1);
+    orders.emplace_back(2, 2, 100, 100, Side::Buy, OrderType::Limit, 2);
+    orders.emplace_back(3, 3, 100, 200, Side::Sell, OrderType::Limit, 3);
+    engine.matchOrder(&orders[0]);
+    engine.matchOrder(&orders[1]);
+
+    engine.matchOrder(&orders[2]);
+
+    EXPECT_EQ(orders[0].getQty(), 150);
+    EXPECT_EQ(orders[1].getQty(), 50);
+    EXPECT_EQ(orders[2].getStatus(), OrderStatus::Executed);
+}
+
+TEST(OrderTraitsTest, WideIDsBeyondThirtyTwoBits) {
+    LimitOrderBookFor<WideIDOrderTraits> book;
+    CancelBothSTP stpPolicy;
+    MatchingEngineFor<WideIDOrderTraits> engine(&stpPolicy, &book);
+    uint64_t bigID = (uint64_t{1} << 40) + 7;
+    WideIDOrder resting(bigID, 1, 100, 10, Side::Sell, OrderType::Limit, 1);
+    WideIDOrder other(bigID + (uint64_t{1} << 32), 2, 100, 10, Side::Sell, OrderType::Limit, 2);
+    WideIDOrder taker(bigID + 1, 3, 100, 15, Side::Buy, OrderType::Limit, 3);
+
+    engine.matchOrder(&resting);
+    engine.matchOrder(&other);
+    EXPECT_TRUE(book.doesOrderExist(bigID));
+    EXPECT_TRUE(book.doesOrderExist(bigID + (uint64_t{1} << 32)));
+
+    engine.matchOrder(&taker);
+
+    ASSERT_EQ(engine.getLastFills().size(), 2u);
+    EXPECT_EQ(engine.getLastFills()[0].makerOrderID, bigID);
+    EXPECT_EQ(engine.getLastFills()[1].makerOrderID, bigID + (uint64_t{1} << 32));
+    EXPECT_EQ(book.removeOrder(bigID + (uint64_t{1} << 32)), RejectionReason::None);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <thread>
+#include "models/matching_engine.hpp"
+#include "order_store.hpp"
+
+namespace {
+struct Stripe {
+    uint64_t a, b, c, d, e;
+};
+}
+
+TEST(SeqlockTest, ConcurrentReadersNeverSeeTornValues) {
+    constexpr int READERS = 3;
+    constexpr uint64_t MIN_STORES = 200000;
+    constexpr uint64_t MIN_READS = 1000;
+    Seqlock<Stripe> cell;
+    std::atomic<int> started{0};
+    std::atomic<bool> done{false};
+    std::array<std::atomic<uint64_t>, READERS> reads{};
+    std::atomic<bool> torn{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&, r] {
+            started.fetch_add(1, std::memory_order_release);
+            uint64_t lastSeen = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                Stripe value = cell.load();
+                if (value.a != value.b || value.b != value.c || value.c != value.d || value.d != value.e || value.a < lastSeen) {
+                    torn = true;
+                }
+                lastSeen = value.a;
+                reads[r].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    while (started.load(std::memory_order_acquire) < READERS) std::this_thread::yield();
+
+    // Keep writing until every reader has overlapped the writer often enough; the periodic
+    // yield lets readers run on a single core.
+    auto everyReaderCaughtUp = [&] {
+        for (auto& count : reads) {
+            if (count.load(std::memory_order_relaxed) < MIN_READS) return false;
+        }
+        return true;
+    };
+    uint64_t stores = 0;
+    while (stores < MIN_STORES || !everyReaderCaughtUp()) {
+        ++stores;
+        cell.store(Stripe{stores, stores, stores, stores, stores});
+        if (stores % 1024 == 0) std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_FALSE(torn.load());
+    for (auto& count : reads) EXPECT_GE(count.load(), MIN_READS);
+    EXPECT_EQ(cell.version(), stores);
+}
+
+class TopOfBookTest : public ::testing::Test {
+protected:
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine{&stpPolicy, &book};
+    TopOfBookFeed feed;
+    OrderStore orders;
+
+    OrderPtr make(OrderID id, PriceTicks price, Quantity qty, Side side, OrderType type = OrderType::Limit) {
+        orders.add(id, id, price, qty, side, type, id);
+        return orders.back();
+    }
+
+    void SetUp() override {
+        engine.setTopOfBookFeed(&feed);
+    }
+};
+
+TEST_F(TopOfBookTest, PublishesBestLevelsAfterEachEvent) {
+    engine.matchOrder(make(1, 99, 10, Side::Buy));
+    engine.matchOrder(make(2, 99, 5, Side::Buy));
+    engine.matchOrder(make(3, 101, 7, Side::Sell));
+
+    TopOfBook top = feed.load();
+    EXPECT_EQ(top.sequence, 3u);
+    EXPECT_EQ(top.bidPrice, 99);
+    EXPECT_EQ(top.bidQty, 15);
+    EXPECT_EQ(top.bidOrders, 2u);
+    EXPECT_EQ(top.askPrice, 101);
+    EXPECT_EQ(top.askQty, 7);
+    EXPECT_EQ(top.askOrders, 1u);
+
+    engine.matchOrder(make(4, 0, 7, Side::Buy, OrderType::Market));
+
+    top = feed.load();
+    EXPECT_EQ(top.sequence, 4u);
+    EXPECT_FALSE(top.hasAsk());
+    EXPECT_EQ(top.askPrice, 0);
+    EXPECT_EQ(top.bidQty, 15);
+}
+
+TEST_F(TopOfBookTest, CallerPublishesAfterDirectCancel) {
+    engine.matchOrder(make(1, 99, 10, Side::Buy));
+    book.removeOrder(1);
+    EXPECT_TRUE(feed.load().hasBid());
+
+    engine.publishTopOfBook();
+
+    EXPECT_FALSE(feed.load().hasBid());
+    EXPECT_EQ(feed.load().sequence, 2u);
+}
+
+TEST_F(TopOfBookTest, ReaderThreadSeesConsistentSnapshots) {
+    std::atomic<bool> done{false};
+    std::atomic<bool> inconsistent{false};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            TopOfBook top = feed.load();
+            if (top.hasBid() && top.hasAsk() && top.bidPrice >= top.askPrice) inconsistent = true;
+            if (top.hasBid() != (top.bidOrders > 0)) inconsistent = true;
+        }
+    });
+    for (OrderID id = 1; id <= 20000; ++id) {
+        Side side = id % 2 ? Side::Buy : Side::Sell;
+        PriceTicks price = side == Side::Buy ? 95 + id % 5 : 100 + id % 5;
+        engine.matchOrder(make(id, price, 10, side, id % 7 == 0 ? OrderType::Market : OrderType::Limit));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_FALSE(inconsistent.load());
+    EXPECT_EQ(feed.load().sequence, 20000u);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <deque>
+#include <utility>
+#include "models/order.hpp"
+
+// Owns the orders a test hands to books and engines by pointer; every pointer stays valid
+// for the store's lifetime.
+class OrderStore {
+    private:
+        std::deque<Order> orders;
+
+    public:
+        template <typename... Args>
+        OrderPtr add(Args&&... args) { return &orders.emplace_back(std::forward<Args>(args)...); }
+
+        inline size_t size() const { return orders.size(); }
+        inline OrderPtr operator[](size_t i) { return &orders[i]; }
+        inline OrderPtr back() { return &orders.back(); }
+};
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "policy/allocation_policy.hpp"
+#include "order_store.hpp"
+
+class AllocationPolicyTest : public ::testing::Test {
+protected:
+    PriceLevel level;
+    OrderStore orders;
+    std::vector<Quantity> allocations;
+
+    void rest(OwnerID owner, Quantity qty) {
+        orders.add(orders.size() + 1, owner, 100, qty, Side::Sell, OrderType::Limit, 1000);
+        level.orders.push_back(orders.back());
+        level.totalQty += qty;
+        allocations.push_back(-1);
+    }
+};
+
+TEST_F(AllocationPolicyTest, FifoFillsInTimePriority) {
+    rest(1, 10);
+    rest(2, 20);
+    rest(3, 30);
+
+    FifoAllocation().allocate(level, 25, allocations);
+
+    EXPECT_EQ(allocations, (std::vector<Quantity>{10, 15, 0}));
+}
+
+TEST_F(AllocationPolicyTest, ProRataSplitsByShareWithFifoRemainder) {
+    rest(1, 10);
+    rest(2, 20);
+    rest(3, 70);
+
+    ProRataAllocation().allocate(level, 15, allocations);
+
+    // floor shares 1, 3, 10 leave 1 lot, which goes to the oldest order
+    EXPECT_EQ(allocations, (std::vector<Quantity>{2, 3, 10}));
+}
+
+TEST_F(AllocationPolicyTest, ProRataDropsSharesBelowMinimum) {
+    rest(1, 5);
+    rest(2, 95);
+
+    ProRataAllocation(3).allocate(level, 40, allocations);
+
+    // order 1's share of 2 is under the minimum; the freed lots go FIFO
+    EXPECT_EQ(allocations, (std::vector<Quantity>{2, 38}));
+}
+
+TEST_F(AllocationPolicyTest, ProRataNeverExceedsLevelOrOrderQty) {
+    rest(1, 3);
+    rest(2, 4);
+
+    ProRataAllocation().allocate(level, 100, allocations);
+
+    EXPECT_EQ(allocations, (std::vector<Quantity>{3, 4}));
+}
+
+TEST_F(AllocationPolicyTest, LmmGetsPriorityShareThenFifo) {
+    rest(1, 50);
+    rest(9, 50);
+    rest(2, 50);
+
+    LmmFifoAllocation({9}, 40).allocate(level, 50, allocations);
+
+    // LMM takes 40% = 20 first, the remaining 30 go FIFO starting with the oldest order
+    EXPECT_EQ(allocations, (std::vector<Quantity>{30, 20, 0}));
+}
+
+TEST_F(AllocationPolicyTest, LmmShareCappedByLmmQty) {
+    rest(1, 50);
+    rest(9, 5);
+
+    LmmFifoAllocation({9}, 50).allocate(level, 40, allocations);
+
+    EXPECT_EQ(allocations, (std::vector<Quantity>{35, 5}));
+}
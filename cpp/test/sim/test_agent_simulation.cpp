@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include "sim/agent_simulation.hpp"
+
+TEST(AgentSimulationTest, SameSeedReproducesTheRun) {
+    AgentSimulationConfig config;
+    config.seed = 42;
+    AgentSimulation<> first(config);
+    AgentSimulation<> second(config);
+
+    first.run(5000);
+    second.run(5000);
+
+    EXPECT_EQ(first.getStats().ordersSubmitted, second.getStats().ordersSubmitted);
+    EXPECT_EQ(first.getStats().volume, second.getStats().volume);
+    EXPECT_EQ(first.getStats().lastTradePrice, second.getStats().lastTradePrice);
+    EXPECT_EQ(first.getLedger().position, second.getLedger().position);
+    EXPECT_EQ(first.getLedger().cash, second.getLedger().cash);
+}
+
+TEST(AgentSimulationTest, FillsAreReportedToBothSides) {
+    AgentSimulationConfig config;
+    AgentSimulation<> simulation(config);
+
+    simulation.run(5000);
+
+    const AgentLedger& ledger = simulation.getLedger();
+    EXPECT_GT(simulation.getStats().fills, 0u);
+    EXPECT_EQ(std::accumulate(ledger.position.begin(), ledger.position.end(), int64_t{0}), 0);
+    EXPECT_EQ(std::accumulate(ledger.cash.begin(), ledger.cash.end(), int64_t{0}), 0);
+    EXPECT_EQ(std::accumulate(ledger.tradedQty.begin(), ledger.tradedQty.end(), int64_t{0}), 2 * simulation.getStats().volume);
+}
+
+TEST(AgentSimulationTest, BookStaysUncrossedAndOrderSlotsBounded) {
+    AgentSimulationConfig config;
+    config.stepsPerDay = 2000;
+    AgentSimulation<> simulation(config);
+
+    simulation.runDays(5);
+
+    EXPECT_EQ(simulation.getAgentCount(), 100u);
+    EXPECT_EQ(simulation.getStats().steps, 10000u);
+    auto bid = simulation.getBook().getBestBid();
+    auto ask = simulation.getBook().getBestAsk();
+    if (bid && ask) {
+        EXPECT_LT(*bid, *ask);
+    }
+    // Noise traders keep at most four orders each and makers two quotes, plus slack for free slots.
+    EXPECT_LE(simulation.getOrderSlotCount(), 60u * 4 + 10u * 2 + 16);
+}
+
+TEST(AgentSimulationTest, RunsOnTheLadderBook) {
+    InstrumentSpec instrument(TickLadder{}, PriceBand{9000, 11000});
+    AgentSimulationConfig config;
+    AgentSimulation<LadderOrderBook> simulation(config, &instrument);
+
+    simulation.run(2000);
+
+    EXPECT_GT(simulation.getStats().volume, 0);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "sim/differential_harness.hpp"
+
+namespace {
+
+// Ladder book that loses any resting order of exactly 37 lots.
+class LossyLadderBook : public LadderOrderBook {
+    public:
+        using LadderOrderBook::LadderOrderBook;
+
+        RejectionReason addOrder(const OrderPtr &order, OrderHandle* handle = nullptr) {
+            if (order->getQty() == 37) return RejectionReason::None;
+            return LadderOrderBook::addOrder(order, handle);
+        }
+};
+
+}
+
+class DifferentialHarnessTest : public ::testing::Test {
+protected:
+    InstrumentSpec instrument{TickLadder(), PriceBand{1, 10000}};
+    CancelRestingSTP stpPolicy;
+};
+
+TEST_F(DifferentialHarnessTest, MapAndLadderBooksAgree) {
+    DifferentialHarness<LimitOrderBook, LadderOrderBook> harness(&instrument, &stpPolicy, 42, 10000);
+
+    DifferentialReport report = harness.run(100000);
+
+    EXPECT_EQ(report.eventsRun, 100000u);
+    EXPECT_FALSE(report.divergence.has_value()) << report.divergence->description;
+}
+
+TEST_F(DifferentialHarnessTest, GeneratorIsDeterministicPerSeed) {
+    HarnessCommandGenerator first(7, 5000, 40);
+    HarnessCommandGenerator second(7, 5000, 40);
+
+    for (int i = 0; i < 1000; ++i) {
+        HarnessCommand a = first();
+        HarnessCommand b = second();
+        EXPECT_EQ(a.kind, b.kind);
+        EXPECT_EQ(a.orderID, b.orderID);
+        EXPECT_EQ(a.price, b.price);
+        EXPECT_EQ(a.qty, b.qty);
+        EXPECT_EQ(a.side, b.side);
+    }
+}
+
+TEST_F(DifferentialHarnessTest, DivergenceIsShrunkToMinimalSequence) {
+    DifferentialHarness<LimitOrderBook, LossyLadderBook> harness(&instrument, &stpPolicy, 3, 64);
+
+    DifferentialReport report = harness.run(100000);
+
+    ASSERT_TRUE(report.divergence.has_value());
+    ASSERT_FALSE(report.minimalFailure.empty());
+    EXPECT_LE(report.minimalFailure.size(), 2u);
+    EXPECT_TRUE(harness.replay(report.minimalFailure, 1).has_value());
+    bool hasLostOrder = false;
+    for (const HarnessCommand &command : report.minimalFailure) {
+        hasLostOrder |= command.kind == HarnessCommand::Kind::Submit && command.qty == 37;
+    }
+    EXPECT_TRUE(hasLostOrder);
+}
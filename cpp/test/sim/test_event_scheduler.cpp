@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "sim/event_scheduler.hpp"
+#include "models/matching_engine.hpp"
+
+TEST(RadixHeapTest, PopsInTimeThenPushOrder) {
+    RadixHeap<int> heap;
+    heap.push(50, 1);
+    heap.push(10, 2);
+    heap.push(50, 3);
+    heap.push(10, 4);
+    heap.push(7, 5);
+
+    std::vector<int> popped;
+    while (!heap.empty()) popped.push_back(heap.pop());
+
+    EXPECT_EQ(popped, (std::vector<int>{5, 2, 4, 1, 3}));
+}
+
+TEST(RadixHeapTest, RejectsPushBeforeLastPopped) {
+    RadixHeap<int> heap;
+    heap.push(100, 1);
+    heap.pop();
+
+    EXPECT_FALSE(heap.push(99, 2));
+    EXPECT_TRUE(heap.push(100, 3));
+    EXPECT_EQ(heap.pop(), 3);
+}
+
+TEST(RadixHeapTest, MatchesSortedOrderUnderInterleavedPushes) {
+    RadixHeap<uint64_t> heap;
+    uint64_t state = 12345;
+    std::vector<std::pair<Timestamp, uint64_t>> expected;
+    std::vector<std::pair<Timestamp, uint64_t>> popped;
+    uint64_t sequence = 0;
+    for (int round = 0; round < 2000; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            Timestamp time = heap.lastPopped() + state % 64;
+            heap.push(time, sequence);
+            expected.emplace_back(time, sequence++);
+        }
+        Timestamp time = heap.topTime();
+        popped.emplace_back(time, heap.pop());
+    }
+    while (!heap.empty()) {
+        Timestamp time = heap.topTime();
+        popped.emplace_back(time, heap.pop());
+    }
+
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(popped.size(), expected.size());
+    for (size_t i = 1; i < popped.size(); ++i) {
+        ASSERT_LE(popped[i - 1], popped[i]);
+    }
+}
+
+TEST(LatencyModelTest, AddsNetworkAndProcessingPerOwner) {
+    LatencyModel latency;
+    latency.setLatency(1, 500, 20);
+    latency.setLatency(2, 5000, 20);
+
+    EXPECT_EQ(latency.arrivalAtExchange(1, 1000), 1520u);
+    EXPECT_EQ(latency.arrivalAtExchange(2, 1000), 6020u);
+    EXPECT_EQ(latency.arrivalAtOwner(1, 1520), 2020u);
+    EXPECT_EQ(latency.arrivalAtExchange(3, 1000), 1000u);
+}
+
+TEST(LatencyModelTest, JitterIsSeeded) {
+    LatencyModel first(7, 100);
+    LatencyModel second(7, 100);
+    first.setLatency(1, 1000, 0);
+    second.setLatency(1, 1000, 0);
+
+    for (int i = 0; i < 100; ++i) {
+        Timestamp arrival = first.arrivalAtExchange(1, 0);
+        EXPECT_EQ(arrival, second.arrivalAtExchange(1, 0));
+        EXPECT_GE(arrival, 1000u);
+        EXPECT_LE(arrival, 1100u);
+    }
+}
+
+TEST(EventSchedulerTest, FasterOwnerReachesTheBookFirst) {
+    struct Submit {
+        OrderID orderID;
+        OwnerID ownerID;
+        Side side;
+    };
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    MatchingEngine engine(&stpPolicy, &book);
+    std::deque<Order> orders;
+    LatencyModel latency;
+    latency.setLatency(1, 5000, 100);
+    latency.setLatency(2, 800, 100);
+    EventScheduler<Submit> scheduler;
+
+    // Both owners decide at t = 1000; owner 2 is closer to the exchange.
+    scheduler.schedule(latency.arrivalAtExchange(1, 1000), Submit{1, 1, Side::Sell});
+    scheduler.schedule(latency.arrivalAtExchange(2, 1000), Submit{2, 2, Side::Sell});
+    scheduler.schedule(SimClock::fromSeconds(1.0), Submit{3, 3, Side::Buy});
+
+    scheduler.runAll([&](Timestamp, const Submit &submit) {
+        OrderPtr order = &orders.emplace_back(
+            scheduler.getClock().stamp(submit.orderID, submit.ownerID, 100, 10, submit.side, OrderType::Limit)
+        );
+        engine.matchOrder(order);
+    });
+
+    EXPECT_EQ(orders[0].getOrderID(), 2u);
+    EXPECT_EQ(orders[0].getTimestamp(), 1900u);
+    EXPECT_EQ(orders[1].getTimestamp(), 6100u);
+    EXPECT_EQ(orders[2].getTimestamp(), SimClock::NANOS_PER_SECOND);
+    ASSERT_EQ(engine.getLastFills().size(), 1u);
+    EXPECT_EQ(engine.getLastFills()[0].makerOrderID, 2u);
+    EXPECT_EQ(scheduler.getProcessedCount(), 3u);
+}
+
+TEST(EventSchedulerTest, HandlersScheduleFollowUpsAndRunUntilStops) {
+    EventScheduler<int> scheduler;
+    std::vector<Timestamp> seen;
+    scheduler.schedule(0, 0);
+
+    auto tick = [&](Timestamp now, int depth) {
+        seen.push_back(now);
+        scheduler.scheduleAfter(SimClock::fromSeconds(1.0), depth + 1);
+    };
+    uint64_t handled = scheduler.runUntil(SimClock::fromSeconds(3.5), tick);
+
+    EXPECT_EQ(handled, 4u);
+    EXPECT_EQ(seen.back(), SimClock::fromSeconds(3.0));
+    EXPECT_EQ(scheduler.now(), SimClock::fromSeconds(3.5));
+    EXPECT_EQ(scheduler.pending(), 1u);
+}
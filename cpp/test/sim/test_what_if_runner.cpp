@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include "sim/what_if_runner.hpp"
+#include "order_store.hpp"
+
+class WhatIfRunnerTest : public ::testing::Test {
+protected:
+    LimitOrderBook book;
+    CancelBothSTP stpPolicy;
+    OrderStore orders;
+
+    void SetUp() override {
+        for (OrderID id = 1; id <= 10; ++id) {
+            orders.add(id, id, 100 + id, 10, Side::Sell, OrderType::Limit, 1000 + id);
+            book.addOrder(orders.back());
+        }
+        orders.add(11, 11, 100, 10, Side::Buy, OrderType::Limit, 1011);
+        book.addOrder(orders.back());
+    }
+};
+
+TEST(ThreadPoolTest, ParallelForRunsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    pool.parallelFor(hits.size(), [&](size_t i) { hits[i]++; });
+    pool.parallelFor(hits.size(), [&](size_t i) { hits[i]++; });
+
+    for (auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 2);
+    }
+}
+
+TEST_F(WhatIfRunnerTest, ForkIsIndependentOfSource) {
+    BookFork fork(book);
+    MatchingEngine engine(&stpPolicy, &fork.getBook());
+    Order sweep(100, 100, 0, 35, Side::Buy, OrderType::Market, 2000);
+
+    engine.matchOrder(&sweep);
+
+    EXPECT_EQ(fork.getRestingOrderCount(), 11u);
+    EXPECT_EQ(sweep.getStatus(), OrderStatus::Executed);
+    EXPECT_EQ(fork.getBook().getBestAsk(), 104);
+    EXPECT_EQ(book.getBestAsk(), 101);
+    EXPECT_EQ(orders[0]->getQty(), 10);
+    EXPECT_EQ(orders[0]->getStatus(), OrderStatus::Pending);
+}
+
+TEST_F(WhatIfRunnerTest, RunsScenariosInParallelOnSeparateForks) {
+    WhatIfRunner runner(&stpPolicy, 4);
+    std::vector<std::optional<PriceTicks>> bestAsks(16);
+    std::vector<OrderStatus> statuses(16);
+
+    runner.run(book, bestAsks.size(), [&](size_t forkIndex, LimitOrderBook &fork, MatchingEngine &engine) {
+        Order sweep(100, 100, 0, static_cast<Quantity>(10 * forkIndex), Side::Buy, OrderType::Market, 2000);
+        engine.matchOrder(&sweep);
+        bestAsks[forkIndex] = fork.getBestAsk();
+        statuses[forkIndex] = sweep.getStatus();
+    });
+
+    for (size_t i = 1; i < bestAsks.size(); ++i) {
+        if (i < 10) {
+            EXPECT_EQ(bestAsks[i], static_cast<PriceTicks>(101 + i));
+            EXPECT_EQ(statuses[i], OrderStatus::Executed);
+        } else {
+            EXPECT_EQ(bestAsks[i], std::nullopt);
+        }
+    }
+    EXPECT_EQ(statuses[15], OrderStatus::CancelledAfterPartialExecution);
+    EXPECT_EQ(book.getBestAsk(), 101);
+    EXPECT_EQ(book.getBestBid(), 100);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "utils/csv_order_loader.hpp"
+
+TEST(DecimalTickConverterTest, ConvertsExactMultiplesOnly) {
+    auto converter = DecimalTickConverter::fromTickSize("0.05");
+    ASSERT_TRUE(converter.has_value());
+    CsvLoadError error = CsvLoadError::None;
+
+    EXPECT_EQ(converter->toTicks("101.25", error), 2025);
+    EXPECT_EQ(converter->toTicks("101.2", error), 2024);
+    EXPECT_EQ(converter->toTicks("101", error), 2020);
+    EXPECT_EQ(converter->toTicks("101.2500", error), 2025);
+    EXPECT_EQ(converter->toTicks(".05", error), 1);
+    EXPECT_EQ(error, CsvLoadError::None);
+
+    EXPECT_FALSE(converter->toTicks("101.26", error).has_value());
+    EXPECT_EQ(error, CsvLoadError::PriceNotOnTick);
+    EXPECT_FALSE(converter->toTicks("101.251", error).has_value());
+    EXPECT_EQ(error, CsvLoadError::PriceNotOnTick);
+    EXPECT_FALSE(converter->toTicks("10x.25", error).has_value());
+    EXPECT_EQ(error, CsvLoadError::BadField);
+    EXPECT_FALSE(converter->toTicks("", error).has_value());
+    EXPECT_EQ(error, CsvLoadError::BadField);
+}
+
+TEST(DecimalTickConverterTest, RejectsInvalidTickSizes) {
+    EXPECT_FALSE(DecimalTickConverter::fromTickSize("0").has_value());
+    EXPECT_FALSE(DecimalTickConverter::fromTickSize("-0.01").has_value());
+    EXPECT_FALSE(DecimalTickConverter::fromTickSize("abc").has_value());
+    EXPECT_TRUE(DecimalTickConverter::fromTickSize("0.0001").has_value());
+}
+
+TEST(CsvOrderLoaderTest, LoadsRowsWithHeaderInAnyOrder) {
+    CsvOrderLoader loader(*DecimalTickConverter::fromTickSize("0.01"));
+    std::vector<Order> orders;
+    std::string_view text =
+        "timestamp,order_id,venue,side,type,price,qty,owner_id\r\n"
+        "1000,1,X,B,L,100.25,10,7\r\n"
+        "\r\n"
+        "1001,2,X,sell,limit,100.30,5,8\r\n"
+        "1002,3,X,BUY,MARKET,,20,9\n";
+
+    CsvLoadResult result = loader.load(text, orders);
+
+    EXPECT_EQ(result.error, CsvLoadError::None);
+    EXPECT_EQ(result.ordersLoaded, 3u);
+    ASSERT_EQ(orders.size(), 3u);
+    EXPECT_EQ(orders[0].getOrderID(), 1u);
+    EXPECT_EQ(orders[0].getOwnerID(), 7u);
+    EXPECT_EQ(orders[0].getPriceTicks(), 10025);
+    EXPECT_EQ(orders[0].getQty(), 10);
+    EXPECT_EQ(orders[0].getSide(), Side::Buy);
+    EXPECT_EQ(orders[0].getTimestamp(), 1000u);
+    EXPECT_EQ(orders[1].getSide(), Side::Sell);
+    EXPECT_EQ(orders[1].getPriceTicks(), 10030);
+    EXPECT_EQ(orders[2].getType(), OrderType::Market);
+    EXPECT_EQ(orders[2].getPriceTicks(), 0);
+}
+
+TEST(CsvOrderLoaderTest, ReportsFirstBadLine) {
+    CsvOrderLoader loader(*DecimalTickConverter::fromTickSize("0.01"));
+    std::vector<Order> orders;
+
+    CsvLoadResult missing = loader.load("order_id,side,type,price,qty,timestamp\n", orders);
+    EXPECT_EQ(missing.error, CsvLoadError::MissingColumn);
+
+    std::string_view header = "order_id,owner_id,side,type,price,qty,timestamp\n";
+    CsvLoadResult badQty = loader.load(std::string(header) + "1,1,B,L,1.00,10,5\n2,1,B,L,1.00,ten,5\n", orders);
+    EXPECT_EQ(badQty.error, CsvLoadError::BadField);
+    EXPECT_EQ(badQty.line, 3u);
+    EXPECT_EQ(badQty.ordersLoaded, 1u);
+
+    CsvLoadResult offTick = loader.load(std::string(header) + "1,1,B,L,1.005,10,5\n", orders);
+    EXPECT_EQ(offTick.error, CsvLoadError::PriceNotOnTick);
+    EXPECT_EQ(offTick.line, 2u);
+
+    CsvLoadResult badSide = loader.load(std::string(header) + "1,1,X,L,1.00,10,5\n", orders);
+    EXPECT_EQ(badSide.error, CsvLoadError::BadField);
+}
+
+TEST(CsvOrderLoaderTest, LoadsMappedFile) {
+    std::string path = ::testing::TempDir() + "csv_order_loader_test.csv";
+    {
+        std::ofstream file(path);
+        file << "order_id,owner_id,side,type,price,qty,timestamp\n";
+        for (int i = 1; i <= 1000; ++i) {
+            file << i << ',' << i % 10 << ',' << (i % 2 ? "B" : "S") << ",L," << 100 + i % 50 << '.' << (i % 4) * 25 << ',' << i << ',' << 1000 + i << '\n';
+        }
+    }
+    CsvOrderLoader loader(*DecimalTickConverter::fromTickSize("0.25"));
+    std::vector<Order> orders;
+
+    CsvLoadResult result = loader.loadFile(path.c_str(), orders);
+
+    EXPECT_EQ(result.error, CsvLoadError::None);
+    ASSERT_EQ(orders.size(), 1000u);
+    EXPECT_EQ(orders[998].getPriceTicks(), (100 + 999 % 50) * 4 + 999 % 4);
+    EXPECT_EQ(loader.loadFile("/nonexistent/orders.csv", orders).error, CsvLoadError::OpenFailed);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include "utils/fenwick_tree.hpp"
+
+TEST(FenwickTreeTest, AppendAddAndPrefix) {
+    FenwickTree<> tree;
+    for (int64_t value : {5, 3, 7, 1, 4}) tree.append(value);
+
+    EXPECT_EQ(tree.size(), 5u);
+    EXPECT_EQ(tree.prefix(0), 0);
+    EXPECT_EQ(tree.prefix(3), 15);
+    EXPECT_EQ(tree.prefix(5), 20);
+
+    tree.add(1, -3);
+    EXPECT_EQ(tree.prefix(2), 5);
+    EXPECT_EQ(tree.prefix(5), 17);
+}
+
+TEST(FenwickTreeTest, AssignBuildsTheSameTreeAsAppends) {
+    std::mt19937 rng(11);
+    std::vector<int64_t> values(300);
+    for (auto& value : values) value = rng() % 100;
+    FenwickTree<> appended;
+    for (int64_t value : values) appended.append(value);
+    FenwickTree<> assigned;
+    assigned.assign(values.begin(), values.end(), [](int64_t value) { return value; });
+
+    for (size_t i = 0; i <= values.size(); ++i) {
+        int64_t expected = std::accumulate(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(i), int64_t{0});
+        ASSERT_EQ(appended.prefix(i), expected);
+        ASSERT_EQ(assigned.prefix(i), expected);
+    }
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <thread>
+#include "models/matching_engine.hpp"
+#include "utils/huge_pages.hpp"
+
+using HugePageOrder = BasicOrder<HugePageOrderTraits>;
+
+class HugePagesTest : public ::testing::Test {
+    protected:
+        void TearDown() override { HugePageArena::install(nullptr); }
+};
+
+TEST_F(HugePagesTest, RegionFallsBackAndRoundsToTwoMegabytes) {
+    HugePageRegion region(3 << 20);
+
+    ASSERT_NE(region.getBacking(), PageBacking::None);
+    EXPECT_EQ(region.size() % (2 << 20), 0u);
+    EXPECT_GE(region.size(), size_t{3} << 20);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(region.begin()) % (2 << 20), 0u);
+    EXPECT_EQ(region.getNode(), -1);
+
+    region.prefault();
+
+    EXPECT_GE(region.getNode(), 0);
+    EXPECT_EQ(region.begin()[region.size() - 1], std::byte{0});
+}
+
+TEST_F(HugePagesTest, ArenaReusesFreedBlocksOfTheSameClass) {
+    HugePageArena arena(2 << 20, PageBacking::Regular);
+    void* a = arena.allocate(40, 8);
+    void* b = arena.allocate(48, 8);
+    EXPECT_EQ(static_cast<std::byte*>(b) - static_cast<std::byte*>(a), 48);
+    size_t used = arena.usedBytes();
+
+    arena.deallocate(a, 40, 8);
+    void* c = arena.allocate(33, 8);
+
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(arena.usedBytes(), used);
+    EXPECT_EQ(arena.getFallbackCount(), 0u);
+}
+
+TEST_F(HugePagesTest, ArenaFallsBackToOperatorNewWhenExhausted) {
+    HugePageArena arena(2 << 20, PageBacking::Regular);
+    void* big = arena.allocate(arena.getRegion().size(), 8);
+    EXPECT_TRUE(arena.getRegion().contains(big));
+
+    void* overflow = arena.allocate(64, 8);
+
+    EXPECT_FALSE(arena.getRegion().contains(overflow));
+    EXPECT_EQ(arena.getFallbackCount(), 1u);
+    arena.deallocate(overflow, 64, 8);
+    arena.deallocate(big, arena.getRegion().size(), 8);
+}
+
+TEST_F(HugePagesTest, BookContainersAllocateFromInstalledArena) {
+    HugePageArena arena(8 << 20);
+    arena.prefault();
+    HugePageArena::install(&arena);
+    std::deque<HugePageOrder> orders;
+    {
+        LimitOrderBookFor<HugePageOrderTraits> book;
+        CancelBothSTP stpPolicy;
+        MatchingEngineFor<HugePageOrderTraits> engine(&stpPolicy, &book);
+        for (uint32_t i = 1; i <= 1000; ++i) {
+            Side side = i % 2 ? Side::Buy : Side::Sell;
+            PriceTicks price = side == Side::Buy ? 100 - i % 10 : 101 + i % 10;
+            engine.matchOrder(&orders.emplace_back(i, i, price, 10, side, OrderType::Limit, i));
+        }
+        EXPECT_GT(arena.usedBytes(), 1000 * sizeof(void*));
+        EXPECT_EQ(arena.getFallbackCount(), 0u);
+
+        HugePageOrder& taker = orders.emplace_back(5000, 5000, 0, 25, Side::Buy, OrderType::Market, 5000);
+        MatchOutcome outcome = engine.matchOrder(&taker);
+        ASSERT_TRUE(outcome.has_value());
+        EXPECT_EQ(outcome->filledQty, 25);
+        EXPECT_EQ(book.getBestAsk(), 101);
+    }
+    size_t used = arena.usedBytes();
+    LimitOrderBookFor<HugePageOrderTraits> rebuilt;
+    for (auto& order : orders) {
+        if (order.getStatus() == OrderStatus::Pending) rebuilt.addOrder(&order);
+    }
+    EXPECT_EQ(arena.usedBytes(), used);
+}
+
+TEST_F(HugePagesTest, InstalledArenaIsPerThreadAndTakesRemoteFrees) {
+    HugePageArena arena(2 << 20, PageBacking::Regular);
+    HugePageArena::install(&arena);
+    HugePageAllocator<uint64_t> allocator;
+    uint64_t* block = allocator.allocate(4);
+    ASSERT_TRUE(arena.getRegion().contains(block));
+    size_t used = arena.usedBytes();
+
+    HugePageArena* seenOnOtherThread = &arena;
+    std::thread other([&] {
+        seenOnOtherThread = HugePageArena::current();
+        HugePageAllocator<uint64_t>().deallocate(block, 4);
+    });
+    other.join();
+
+    EXPECT_EQ(seenOnOtherThread, nullptr);
+    EXPECT_EQ(HugePageArena::ownerOf(block), &arena);
+    EXPECT_EQ(allocator.allocate(4), block);
+    EXPECT_EQ(arena.usedBytes(), used);
+}
+
+TEST_F(HugePagesTest, AllocatorUsesOperatorNewWithoutArena) {
+    LimitOrderBookFor<HugePageOrderTraits> book;
+    HugePageOrder order(1, 1, 100, 10, Side::Buy, OrderType::Limit, 1);
+
+    EXPECT_EQ(book.addOrder(&order), RejectionReason::None);
+    EXPECT_EQ(book.removeOrder(1), RejectionReason::None);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "utils/occupancy_bitmap.hpp"
+
+TEST(OccupancyBitmapTest, EmptyBitmapFindsNothing) {
+    OccupancyBitmap bitmap(1000);
+
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_EQ(bitmap.findFirst(), OccupancyBitmap::npos);
+    EXPECT_EQ(bitmap.findLast(), OccupancyBitmap::npos);
+    EXPECT_EQ(bitmap.findNext(500), OccupancyBitmap::npos);
+    EXPECT_EQ(bitmap.findPrev(500), OccupancyBitmap::npos);
+}
+
+TEST(OccupancyBitmapTest, SetClearAndSearchAcrossLayers) {
+    OccupancyBitmap bitmap(300000);
+    bitmap.set(5);
+    bitmap.set(4096);
+    bitmap.set(299999);
+
+    EXPECT_FALSE(bitmap.empty());
+    EXPECT_EQ(bitmap.findFirst(), 5u);
+    EXPECT_EQ(bitmap.findLast(), 299999u);
+    EXPECT_EQ(bitmap.findNext(6), 4096u);
+    EXPECT_EQ(bitmap.findNext(4097), 299999u);
+    EXPECT_EQ(bitmap.findPrev(4095), 5u);
+    EXPECT_EQ(bitmap.findPrev(299998), 4096u);
+    EXPECT_EQ(bitmap.findPrev(4), OccupancyBitmap::npos);
+
+    bitmap.clear(4096);
+    EXPECT_FALSE(bitmap.test(4096));
+    EXPECT_EQ(bitmap.findNext(6), 299999u);
+    EXPECT_EQ(bitmap.findPrev(299998), 5u);
+
+    bitmap.clear(5);
+    bitmap.clear(299999);
+    EXPECT_TRUE(bitmap.empty());
+}
+
+TEST(OccupancyBitmapTest, MatchesOrderedSetUnderRandomUpdates) {
+    constexpr size_t size = 70000;
+    OccupancyBitmap bitmap(size);
+    std::set<size_t> reference;
+    std::mt19937_64 rng(7);
+
+    for (int step = 0; step < 20000; ++step) {
+        size_t slot = rng() % size;
+        if (rng() % 3 == 0) {
+            bitmap.clear(slot);
+            reference.erase(slot);
+        } else {
+            bitmap.set(slot);
+            reference.insert(slot);
+        }
+        size_t probe = rng() % size;
+        auto next = reference.lower_bound(probe);
+        EXPECT_EQ(bitmap.findNext(probe), next == reference.end() ? OccupancyBitmap::npos : *next);
+        auto after = reference.upper_bound(probe);
+        size_t expectedPrev = after == reference.begin() ? OccupancyBitmap::npos : *std::prev(after);
+        EXPECT_EQ(bitmap.findPrev(probe), expectedPrev);
+    }
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "utils/spsc_ring.hpp"
+
+TEST(SpscRingTest, RoundsCapacityAndReportsFull) {
+    SpscRing<int> ring(5);
+
+    EXPECT_EQ(ring.capacity(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(8));
+
+    int value = -1;
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.tryPush(8));
+}
+
+TEST(SpscRingTest, DrainHandsOverInOrderUpToLimit) {
+    SpscRing<int> ring(16);
+    for (int i = 0; i < 10; ++i) ring.tryPush(i);
+
+    std::vector<int> seen;
+    EXPECT_EQ(ring.drain([&](int v) { seen.push_back(v); }, 4), 4u);
+    EXPECT_EQ(ring.drain([&](int v) { seen.push_back(v); }), 6u);
+    EXPECT_EQ(ring.drain([&](int v) { seen.push_back(v); }), 0u);
+
+    EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, ConsumerThreadSeesEveryValueInOrder) {
+    SpscRing<uint64_t> ring(64);
+    constexpr uint64_t COUNT = 1'000'000;
+    bool ordered = true;
+    std::thread consumer([&] {
+        uint64_t expected = 0;
+        while (expected < COUNT) {
+            uint64_t value;
+            if (ring.tryPop(value)) {
+                ordered &= value == expected;
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        while (!ring.tryPush(i)) std::this_thread::yield();
+    }
+    consumer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}